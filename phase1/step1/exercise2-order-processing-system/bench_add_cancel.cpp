@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "bench_random.h"
+#include "order.h"
+#include "order_processing_system.h"
+
+// Mixed add/cancel flow where 90% of added orders are cancelled, as on a
+// busy venue. Limit orders rest away from the touch so nothing trades and
+// every message is an add or a cancel. Reports ns per message, the pool
+// capacity against the peak live count, and the cost of bulk cancels.
+
+int main() {
+    const std::size_t messageCount = 4'000'000;
+    const char* symbols[] = {"AAPL", "GOOG", "MSFT", "AMZN", "NVDA", "META", "TSLA", "NFLX"};
+
+    // Adds with probability 1 / 1.9 give 0.9 cancels per add
+    struct Message {
+        bool add;
+        Order order;         // For adds
+        std::size_t victim;  // For cancels: index into the live list at that point
+    };
+    std::vector<Message> messages;
+    messages.reserve(messageCount);
+    uint64_t state = 42;
+    std::size_t live = 0;
+    std::size_t peakLive = 0;
+    int nextId = 1;
+    for (std::size_t i = 0; i < messageCount; i++) {
+        const uint64_t r = nextRandom(state);
+        if (live == 0 || r % 1900 < 1000) {
+            const Side side = (r >> 12) & 1 ? Side::BUY : Side::SELL;
+            const int ticks = 1 + static_cast<int>((r >> 16) % 50);
+            const double price = side == Side::BUY ? 100.0 - ticks * 0.01 : 100.0 + ticks * 0.01;
+            messages.push_back(Message{true, Order(nextId++, symbols[(r >> 24) % 8], 100, price, OrderType::LIMIT, side), 0});
+            live++;
+            peakLive = std::max(peakLive, live);
+        } else {
+            messages.push_back(Message{false, Order(), static_cast<std::size_t>((r >> 32) % live)});
+            live--;
+        }
+    }
+
+    // Sized for the peak live count: every later add reuses a cancelled slot
+    OrderProcessingSystem exchange(peakLive);
+    const std::size_t startCapacity = exchange.orderCapacity();
+    std::vector<int> liveIds;
+    liveIds.reserve(peakLive);
+    std::size_t adds = 0;
+    std::size_t cancels = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages) {
+        if (message.add) {
+            exchange.submitOrder(message.order);
+            liveIds.push_back(message.order.orderId);
+            adds++;
+        } else {
+            const int id = liveIds[message.victim];
+            liveIds[message.victim] = liveIds.back();
+            liveIds.pop_back();
+            if (!exchange.cancelOrder(id)) {
+                std::cerr << "Cancel of live order " << id << " failed\n";
+                return 1;
+            }
+            cancels++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    std::cout << "Messages: " << messageCount << " (" << adds << " adds, " << cancels << " cancels, "
+              << std::fixed << std::setprecision(1) << 100.0 * cancels / adds << "% cancelled)\n";
+    std::cout << "Mixed flow: " << std::setprecision(1) << ns / messageCount << " ns/message, "
+              << std::setprecision(2) << messageCount / ns * 1e3 << " M messages/s\n";
+    std::cout << "Live orders: " << exchange.orderCount() << " at end, " << peakLive << " at peak; " << adds
+              << " adds went through a pool of " << startCapacity << " slots (" << exchange.orderCapacity()
+              << " at end)\n";
+
+    const std::size_t beforeBulk = exchange.orderCount();
+    start = std::chrono::steady_clock::now();
+    const std::size_t bySymbol = exchange.cancelSymbol("AAPL");
+    end = std::chrono::steady_clock::now();
+    std::cout << "cancelSymbol(AAPL): " << bySymbol << " orders in "
+              << std::chrono::duration<double, std::micro>(end - start).count() << " us\n";
+
+    start = std::chrono::steady_clock::now();
+    const std::size_t all = exchange.cancelAll();
+    end = std::chrono::steady_clock::now();
+    std::cout << "cancelAll: " << all << " orders in " << std::chrono::duration<double, std::micro>(end - start).count()
+              << " us, " << exchange.orderCount() << " left\n";
+    if (bySymbol + all != beforeBulk || exchange.getMatchingEngine().restingOrderCount() != 0) {
+        std::cerr << "Bulk cancel left orders behind\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "bench_random.h"
+#include "execution_report.h"
+#include "matching_engine.h"
+#include "order.h"
+
+// Drives MatchingEngine with a synthetic flow of limit and market orders on a
+// handful of symbols and reports orders per second on one core.
+
+// Counts reports without doing anything else with them
+class CountingListener : public ExecutionListener {
+    public:
+        std::size_t reports = 0;
+        std::size_t fills = 0;
+
+        void onExecution(const ExecutionReport& report) override {
+            reports++;
+            fills += report.execType == ExecType::FILL || report.execType == ExecType::PARTIAL_FILL;
+        }
+};
+
+int main() {
+    const std::size_t orderCount = 2'000'000;
+    const int runs = 5;
+    const char* symbols[] = {"AAPL", "GOOG", "MSFT", "AMZN"};
+
+    // 90% limit orders within 20 ticks of the mid, 10% market orders
+    std::vector<Order> flow;
+    flow.reserve(orderCount);
+    uint64_t state = 42;
+    for (std::size_t i = 0; i < orderCount; i++) {
+        const uint64_t r = nextRandom(state);
+        const Side side = (r & 1) ? Side::BUY : Side::SELL;
+        const OrderType type = (r >> 1) % 10 == 0 ? OrderType::MARKET : OrderType::LIMIT;
+        const int ticks = static_cast<int>((r >> 8) % 20);
+        // Buys lean below the mid and sells above, with some overlap so orders cross
+        const double price = 100.0 + (side == Side::BUY ? ticks - 15 : 15 - ticks) * 0.01;
+        const int quantity = 1 + static_cast<int>((r >> 32) % 500);
+        flow.emplace_back(static_cast<int>(i + 1), symbols[(r >> 16) % 4], quantity, price, type, side);
+    }
+
+    double best = 1e300;
+    for (int run = 0; run < runs; run++) {
+        MatchingEngine engine(orderCount);
+        CountingListener listener;
+        engine.setExecutionListener(&listener);
+        long long filled = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& order : flow) {
+            filled += engine.submit(order);
+        }
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+
+        if (run == 0) {
+            std::cout << "Orders: " << orderCount << ", reports: " << listener.reports << ", fills: "
+                      << listener.fills << ", filled quantity: " << filled << ", resting at end: "
+                      << engine.restingOrderCount() << "\n";
+        }
+    }
+    std::cout << "Best of " << runs << ": " << best / orderCount << " ns/order, "
+              << orderCount / best * 1e3 << " M orders/s\n";
+    return 0;
+}
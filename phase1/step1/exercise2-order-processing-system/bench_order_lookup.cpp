@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench_random.h"
+#include "order.h"
+#include "order_processing_system.h"
+
+// Compares the hash-indexed getOrderById against the previous linear scan
+// that returned a copy, at 1K, 100K and 10M stored orders.
+
+static volatile long long sink;
+
+// The lookup as it was before the index: O(n) and a copy of the order
+static Order linearGetOrderById(const std::vector<Order>& orders, int id) {
+    for (const auto& order : orders) {
+        if (order.orderId == id) {
+            return order;
+        }
+    }
+    throw std::invalid_argument("Order not found");
+}
+
+int main() {
+    const std::vector<std::size_t> sizes = {1'000, 100'000, 10'000'000};
+    const char* symbols[] = {"AAPL", "GOOG", "MSFT", "AMZN", "NVDA", "META", "TSLA", "BRK.B"};
+
+    std::cout << std::left << std::setw(12) << "orders" << std::right << std::setw(16) << "indexed ns"
+              << std::setw(16) << "linear ns" << std::setw(12) << "speedup" << "\n";
+
+    for (std::size_t n : sizes) {
+        OrderProcessingSystem system(n);
+        std::vector<Order> baseline;
+        baseline.reserve(n);
+        for (std::size_t i = 0; i < n; i++) {
+            Order order(static_cast<int>(i + 1), symbols[i % 8], 1 + static_cast<int>(i % 1000),
+                        100.0 + static_cast<double>(i % 500) * 0.01, OrderType::LIMIT);
+            system.addOrder(order);
+            baseline.push_back(order);
+        }
+
+        // Random ids so lookups hit the whole table rather than a warm prefix
+        const std::size_t indexedLookups = 5'000'000;
+        std::vector<int> ids(indexedLookups);
+        uint64_t state = 42;
+        for (auto& id : ids) {
+            id = 1 + static_cast<int>(nextRandom(state) % n);
+        }
+
+        long long total = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int id : ids) {
+            total += system.getOrderById(id).quantity;
+        }
+        auto end = std::chrono::steady_clock::now();
+        sink = total;
+        const double indexedNs = std::chrono::duration<double, std::nano>(end - start).count() / indexedLookups;
+
+        // Keep the scan to about 1e9 order visits in total
+        const std::size_t linearLookups = std::clamp<std::size_t>(2'000'000'000 / n, 10, indexedLookups);
+        total = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < linearLookups; i++) {
+            total += linearGetOrderById(baseline, ids[i]).quantity;
+        }
+        end = std::chrono::steady_clock::now();
+        sink = total;
+        const double linearNs = std::chrono::duration<double, std::nano>(end - start).count() / linearLookups;
+
+        std::cout << std::left << std::setw(12) << n << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(16) << indexedNs << std::setw(16) << linearNs << std::setw(11)
+                  << std::setprecision(0) << linearNs / indexedNs << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "bench_random.h"
+#include "order.h"
+
+// Validates a stream of raw order requests with a given share of bad ones
+// three ways and reports ns per request for each:
+//   original - LegacyOrder below, a copy of the validating constructor Order
+//              had before Order::create (sequential checks, throw on failure)
+//   ctor     - today's Order constructor: Order::create plus a throw on failure
+//   expected - Order::create, no exceptions
+// The speedup column compares expected against original.
+
+static volatile long long sink;
+
+// Fields as they arrive from a client, before validation
+struct OrderRequest {
+    int id;
+    std::string_view symbol;
+    int quantity;
+    double price;
+    OrderType type;
+    Side side;
+};
+
+// The Order constructor as it was before Order::create, kept as the baseline
+struct LegacyOrder {
+    int orderId;
+    int quantity;
+    double price;
+    Symbol symbol;
+    OrderType orderType;
+    Side side;
+
+    LegacyOrder(int id, std::string_view sym, int qty, double prc, OrderType type, Side sd = Side::BUY)
+        : orderId(id), quantity(qty), price(prc), orderType(type), side(sd) {
+        if (type != OrderType::MARKET && type != OrderType::LIMIT && type != OrderType::STOP) {
+            throw std::invalid_argument("Invalid order type");
+        }
+        if (sd != Side::BUY && sd != Side::SELL) {
+            throw std::invalid_argument("Invalid side");
+        }
+        if (prc <= 0) {
+            throw std::invalid_argument("Price must be positive");
+        }
+        if (qty > 100000 || qty < 1) {
+            throw std::invalid_argument("Quantity must be between 1 and 100000");
+        }
+        if (sym.length() > 8) {
+            throw std::invalid_argument("Symbol must be 8 chars max");
+        }
+        symbol = Symbol(sym);
+    }
+};
+
+// Validate every request with a throwing constructor; returns ns per request
+template <typename OrderT>
+static double timeThrowing(const std::vector<OrderRequest>& requests, long long& accepted) {
+    accepted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& request : requests) {
+        try {
+            OrderT order(request.id, request.symbol, request.quantity, request.price, request.type, request.side);
+            accepted += order.quantity;
+        } catch (const std::invalid_argument&) {
+            accepted--;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / requests.size();
+}
+
+static std::vector<OrderRequest> makeRequests(std::size_t count, int rejectPercent) {
+    std::vector<OrderRequest> requests;
+    requests.reserve(count);
+    uint64_t state = 7;
+    for (std::size_t i = 0; i < count; i++) {
+        const uint64_t r = nextRandom(state);
+        OrderRequest request{static_cast<int>(i + 1), "AAPL", 1 + static_cast<int>(r % 1000), 150.0,
+                             OrderType::LIMIT, (r >> 10) & 1 ? Side::BUY : Side::SELL};
+        if (static_cast<int>((r >> 16) % 100) < rejectPercent) {
+            // Spread rejects over every kind of check
+            switch ((r >> 32) % 4) {
+                case 0: request.quantity = 0; break;
+                case 1: request.price = -1.0; break;
+                case 2: request.symbol = "TOOLONGSYM"; break;
+                default: request.type = static_cast<OrderType>('X'); break;
+            }
+        }
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+int main() {
+    const std::size_t count = 1'000'000;
+
+    std::cout << std::setw(10) << "reject %" << std::setw(18) << "original ns/req" << std::setw(14)
+              << "ctor ns/req" << std::setw(18) << "expected ns/req" << std::setw(10) << "speedup" << "\n";
+    for (int rejectPercent : {0, 1, 10, 50, 100}) {
+        const std::vector<OrderRequest> requests = makeRequests(count, rejectPercent);
+
+        long long originalAccepted = 0;
+        const double originalNs = timeThrowing<LegacyOrder>(requests, originalAccepted);
+        long long accepted = 0;
+        const double ctorNs = timeThrowing<Order>(requests, accepted);
+        sink = accepted;
+
+        accepted = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& request : requests) {
+            const auto order = Order::create(request.id, request.symbol, request.quantity, request.price,
+                                             request.type, request.side);
+            accepted += order ? order->quantity : -1;
+        }
+        auto end = std::chrono::steady_clock::now();
+        const long long expectedAccepted = accepted;
+        const double expectedNs = std::chrono::duration<double, std::nano>(end - start).count() / count;
+
+        if (expectedAccepted != sink || originalAccepted != sink) {
+            std::cerr << "Original, constructor and non-throwing validation disagree\n";
+            return 1;
+        }
+        std::cout << std::setw(10) << rejectPercent << std::fixed << std::setprecision(1) << std::setw(18)
+                  << originalNs << std::setw(14) << ctorNs << std::setw(18) << expectedNs << std::setw(9)
+                  << originalNs / expectedNs << "x\n";
+    }
+    return 0;
+}
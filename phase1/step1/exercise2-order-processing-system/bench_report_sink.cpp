@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "order.h"
+#include "report_sink.h"
+
+// Cost of reporting one order: the old per-order `std::cout << ... <<
+// std::endl` chain against the buffered text, binary and no-op sinks. Output
+// goes to /dev/null so the numbers show formatting and flushing cost rather
+// than terminal speed. "caller" is the time the reporting thread spends,
+// "synced" also waits for the sink's writer thread to finish.
+
+// executeOrder as it was before the sinks: one stream chain and a flush per order
+static void legacyExecuteOrder(std::ostream& out, const Order& order) {
+    switch (order.orderType) {
+        case OrderType::MARKET:
+            out << "Order ID: " << order.orderId << ", Symbol: " << order.symbol << ", Quantity: " << order.quantity << ", Price: " << order.price << ", Order Type: Market" << std::endl;
+            break;
+        case OrderType::LIMIT:
+            out << "Order ID: " << order.orderId << ", Symbol: " << order.symbol << ", Quantity: " << order.quantity << ", Price: " << order.price << ", Order Type: Limit" << std::endl;
+            break;
+        case OrderType::STOP:
+            out << "Order ID: " << order.orderId << ", Symbol: " << order.symbol << ", Quantity: " << order.quantity << ", Price: " << order.price << ", Order Type: Stop" << std::endl;
+            break;
+        default:
+            out << "Invalid order type" << std::endl;
+            break;
+    }
+}
+
+int main() {
+    const std::size_t count = 1'000'000;
+    const char* symbols[] = {"AAPL", "GOOG", "MSFT", "AMZN"};
+    const OrderType types[] = {OrderType::MARKET, OrderType::LIMIT, OrderType::STOP};
+
+    std::vector<Order> orders;
+    orders.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        orders.emplace_back(static_cast<int>(i + 1), symbols[i % 4], 1 + static_cast<int>(i % 1000),
+                            100.0 + static_cast<double>(i % 997) * 0.01, types[i % 3]);
+    }
+
+    // The text sink must print exactly what the stream chain printed
+    for (double price : {150.0, 150.1, 150.123456, 99.995, 0.0001, 1e6, 1234567.0}) {
+        const Order order(1, "AAPL", 100, price, OrderType::LIMIT);
+        std::ostringstream legacy;
+        std::ostringstream buffered;
+        legacyExecuteOrder(legacy, order);
+        {
+            TextSink sink(buffered);
+            sink.writeOrder(order);
+        }
+        if (legacy.str() != buffered.str()) {
+            std::cerr << "Text sink differs from the stream chain:\n" << legacy.str() << buffered.str();
+            return 1;
+        }
+    }
+
+    std::ofstream devNull("/dev/null", std::ios::binary);
+    TextSink text(devNull);
+    BinarySink binary(devNull);
+    NullSink null;
+
+    struct Variant {
+        std::string name;
+        std::function<void(const Order&)> write;
+        ReportSink* sink;  // nullptr for the stream chain, which writes synchronously
+    };
+    const std::vector<Variant> variants = {
+        {"cout+endl", [&](const Order& order) { legacyExecuteOrder(devNull, order); }, nullptr},
+        {"text sink", [&](const Order& order) { text.writeOrder(order); }, &text},
+        {"binary sink", [&](const Order& order) { binary.writeOrder(order); }, &binary},
+        {"null sink", [&](const Order& order) { null.writeOrder(order); }, &null},
+    };
+
+    std::cout << std::left << std::setw(14) << "writer" << std::right << std::setw(18) << "caller ns/order"
+              << std::setw(18) << "synced ns/order" << "\n";
+    for (const auto& variant : variants) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& order : orders) {
+            variant.write(order);
+        }
+        if (variant.sink != nullptr) variant.sink->flush();
+        auto handedOff = std::chrono::steady_clock::now();
+        if (variant.sink != nullptr) variant.sink->sync();
+        auto end = std::chrono::steady_clock::now();
+        std::cout << std::left << std::setw(14) << variant.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(18) << std::chrono::duration<double, std::nano>(handedOff - start).count() / count
+                  << std::setw(18) << std::chrono::duration<double, std::nano>(end - start).count() / count << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "order.h"
+#include "order_processing_system.h"
+
+// Price cascade: a ladder of offers one tick apart and a ladder of buy stops
+// one tick apart just above the market. One market buy prints the first
+// trade, every triggered stop lifts the next offer, and that print triggers
+// the next stop, until the whole ladder has fired. Far-away stops that never
+// trigger sit in the same book to show release cost does not depend on them.
+
+int main() {
+    const std::vector<int> cascadeSizes = {1'000, 10'000, 100'000};
+    const int idleStops = 100'000;
+    const double tick = 0.01;
+    const double mid = 100.0;
+
+    std::cout << std::setw(14) << "cascade stops" << std::setw(12) << "idle stops" << std::setw(12) << "ms total"
+              << std::setw(16) << "ns/stop fired" << "\n";
+    for (int cascade : cascadeSizes) {
+        OrderProcessingSystem exchange(2 * static_cast<std::size_t>(cascade) + idleStops + 16);
+        int id = 1;
+        // One offer per tick, each exactly the size of one stop
+        for (int i = 0; i <= cascade; i++) {
+            exchange.submitOrder(Order(id++, "ES", 100, mid + (i + 1) * tick, OrderType::LIMIT, Side::SELL));
+        }
+        // Buy stop i triggers at offer i's price and buys offer i + 1
+        for (int i = 0; i < cascade; i++) {
+            exchange.submitOrder(Order(id++, "ES", 100, mid + (i + 1) * tick, OrderType::STOP, Side::BUY));
+        }
+        // Sell stops far below the market that never fire
+        for (int i = 0; i < idleStops; i++) {
+            exchange.submitOrder(Order(id++, "ES", 100, mid / 2 - (i % 1000) * tick, OrderType::STOP,
+                                       Side::SELL));
+        }
+        const std::size_t pendingBefore = exchange.getStopTriggerEngine().pendingStopCount();
+
+        auto start = std::chrono::steady_clock::now();
+        exchange.submitOrder(Order(id++, "ES", 100, mid, OrderType::MARKET, Side::BUY));
+        auto end = std::chrono::steady_clock::now();
+
+        const std::size_t fired = pendingBefore - exchange.getStopTriggerEngine().pendingStopCount();
+        if (fired != static_cast<std::size_t>(cascade)) {
+            std::cerr << "Expected " << cascade << " stops to fire, got " << fired << "\n";
+            return 1;
+        }
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::cout << std::setw(14) << cascade << std::setw(12) << idleStops << std::fixed << std::setprecision(2)
+                  << std::setw(12) << ns / 1e6 << std::setw(16) << std::setprecision(0) << ns / fired << "\n";
+    }
+    return 0;
+}
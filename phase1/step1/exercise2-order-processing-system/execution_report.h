@@ -0,0 +1,39 @@
+#ifndef EXECUTION_REPORT_H
+#define EXECUTION_REPORT_H
+
+#include <type_traits>
+
+#include "order.h"
+
+// What an execution report is telling the owner of the order
+enum class ExecType: char {
+    NEW = '0',           // Accepted and resting on the book
+    PARTIAL_FILL = '1',
+    FILL = '2',
+    CANCELLED = '4',     // Removed, or the unfilled rest of a market order
+    REJECTED = '8'
+};
+
+// One event for one order. A fill produces two reports: one for the
+// aggressor and one for the resting order, each naming the other as contra.
+struct ExecutionReport {
+    int orderId;
+    int contraOrderId;   // 0 unless this is a fill
+    int lastQuantity;    // Filled by this event
+    int leavesQuantity;  // Still open after this event
+    double lastPrice;
+    ExecType execType;
+    Side side;
+};
+
+static_assert(std::is_trivially_copyable_v<ExecutionReport>, "ExecutionReport is copied as raw bytes");
+static_assert(std::is_standard_layout_v<ExecutionReport>, "ExecutionReport has a fixed, C-compatible layout");
+
+// Receives reports as orders are matched
+class ExecutionListener {
+    public:
+        virtual ~ExecutionListener() = default;
+        virtual void onExecution(const ExecutionReport& report) = 0;
+};
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef MATCHING_ENGINE_H
+#define MATCHING_ENGINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "execution_report.h"
+#include "order.h"
+#include "order_index.h"
+
+// Price-time priority matching, one book per symbol.
+//
+// LIMIT orders trade against the opposite side while it crosses their price
+// and rest whatever is left. MARKET orders sweep the opposite side and the
+// unfilled remainder is cancelled (immediate-or-cancel). Every accepted order
+// gets a NEW report, then one report per fill, to both the aggressor and the
+// resting order.
+//
+// Each side is a vector of price levels sorted worst to best, so the best
+// level is back(): sweeping pops from the end and new levels near the top of
+// book shift only a few entries. Resting orders live in one pool threaded
+// into per-level FIFO lists and recycled through a free list. With the pool,
+// id index and level vectors reserved up front, submitting and matching do
+// not allocate; only the first order for a new symbol creates its book.
+class MatchingEngine {
+    private:
+        static constexpr uint32_t nullSlot = UINT32_MAX;
+
+        struct RestingOrder {
+            int orderId;
+            int quantity;
+            double price;
+            uint32_t book;
+            uint32_t prev;  // Older order at the same level
+            uint32_t next;  // Newer order at the same level (free list link when unused)
+            Side side;
+        };
+
+        struct Level {
+            double price;
+            int64_t totalQuantity;
+            uint32_t head;  // Oldest order, first to fill
+            uint32_t tail;
+        };
+
+        struct Book {
+            std::vector<Level> bids;  // Worst (lowest) to best (highest)
+            std::vector<Level> asks;  // Worst (highest) to best (lowest)
+            double lastTradePrice = 0.0;  // 0 until the first fill
+        };
+
+        std::vector<RestingOrder> pool;
+        uint32_t freeList = nullSlot;
+        std::size_t restingCount = 0;
+        OrderIndex restingIndex;  // orderId -> pool slot, resting orders only
+        std::vector<Book> books;
+        std::unordered_map<uint64_t, uint32_t> bookIds;  // Symbol key -> book
+        std::size_t levelsPerSide;
+        ExecutionListener* listener = nullptr;
+
+        void emit(const ExecutionReport& report) {
+            if (listener != nullptr) {
+                listener->onExecution(report);
+            }
+        }
+
+        uint32_t bookFor(Symbol symbol) {
+            auto [it, inserted] = bookIds.try_emplace(symbol.key(), static_cast<uint32_t>(books.size()));
+            if (inserted) {
+                books.emplace_back();
+                books.back().bids.reserve(levelsPerSide);
+                books.back().asks.reserve(levelsPerSide);
+            }
+            return it->second;
+        }
+
+        // True if an incoming order on `side` limited at `limit` trades at `restingPrice`
+        static bool crosses(Side side, double limit, double restingPrice) {
+            return side == Side::BUY ? restingPrice <= limit : restingPrice >= limit;
+        }
+
+        // First level at or better than `price` in a worst-to-best side
+        static std::vector<Level>::iterator findLevel(std::vector<Level>& levels, Side side, double price) {
+            return std::lower_bound(levels.begin(), levels.end(), price, [side](const Level& level, double p) {
+                return side == Side::BUY ? level.price < p : level.price > p;
+            });
+        }
+
+        uint32_t allocate() {
+            if (freeList != nullSlot) {
+                const uint32_t slot = freeList;
+                freeList = pool[slot].next;
+                return slot;
+            }
+            pool.emplace_back();
+            return static_cast<uint32_t>(pool.size() - 1);
+        }
+
+        void release(uint32_t slot) {
+            pool[slot].next = freeList;
+            freeList = slot;
+        }
+
+        void rest(const Order& order, uint32_t book, int quantity) {
+            const uint32_t slot = allocate();
+            pool[slot] = RestingOrder{order.orderId, quantity, order.price, book, nullSlot, nullSlot, order.side};
+            restingIndex.insert(order.orderId, slot);
+            restingCount++;
+
+            auto& levels = order.side == Side::BUY ? books[book].bids : books[book].asks;
+            auto it = findLevel(levels, order.side, order.price);
+            if (it == levels.end() || it->price != order.price) {
+                it = levels.insert(it, Level{order.price, 0, nullSlot, nullSlot});
+            }
+            pool[slot].prev = it->tail;
+            if (it->tail != nullSlot) {
+                pool[it->tail].next = slot;
+            } else {
+                it->head = slot;
+            }
+            it->tail = slot;
+            it->totalQuantity += quantity;
+        }
+
+        // Fill up to `remaining` against the opposite side; returns what is left
+        int match(const Order& order, uint32_t book, int remaining) {
+            auto& opposite = order.side == Side::BUY ? books[book].asks : books[book].bids;
+            const Side restingSide = order.side == Side::BUY ? Side::SELL : Side::BUY;
+            const bool market = order.orderType == OrderType::MARKET;
+
+            while (remaining > 0 && !opposite.empty()) {
+                Level& best = opposite.back();
+                if (!market && !crosses(order.side, order.price, best.price)) break;
+
+                while (remaining > 0 && best.head != nullSlot) {
+                    const uint32_t slot = best.head;
+                    RestingOrder& resting = pool[slot];
+                    const int traded = std::min(remaining, resting.quantity);
+                    remaining -= traded;
+                    resting.quantity -= traded;
+                    best.totalQuantity -= traded;
+                    books[book].lastTradePrice = best.price;
+
+                    emit(ExecutionReport{order.orderId, resting.orderId, traded, remaining, best.price,
+                                         remaining == 0 ? ExecType::FILL : ExecType::PARTIAL_FILL, order.side});
+                    emit(ExecutionReport{resting.orderId, order.orderId, traded, resting.quantity, best.price,
+                                         resting.quantity == 0 ? ExecType::FILL : ExecType::PARTIAL_FILL,
+                                         restingSide});
+
+                    if (resting.quantity == 0) {
+                        best.head = resting.next;
+                        if (best.head != nullSlot) {
+                            pool[best.head].prev = nullSlot;
+                        } else {
+                            best.tail = nullSlot;
+                        }
+                        restingIndex.erase(resting.orderId);
+                        restingCount--;
+                        release(slot);
+                    }
+                }
+                if (best.head == nullSlot) {
+                    opposite.pop_back();
+                }
+            }
+            return remaining;
+        }
+
+    public:
+        explicit MatchingEngine(std::size_t expectedOrders = 1 << 16, std::size_t levelsPerSide = 256)
+            : restingIndex(expectedOrders), levelsPerSide(levelsPerSide) {
+            pool.reserve(expectedOrders);
+        }
+
+        // Listener receives every report; nullptr disables reporting
+        void setExecutionListener(ExecutionListener* executionListener) {
+            listener = executionListener;
+        }
+
+        // Match an incoming order. Returns the quantity filled immediately.
+        // Ids that are already resting are rejected, and so are STOP orders:
+        // those wait in a StopTriggerEngine and arrive here once triggered.
+        int submit(const Order& order) {
+            if (order.orderType == OrderType::STOP || restingIndex.find(order.orderId) != OrderIndex::emptySlot) {
+                emit(ExecutionReport{order.orderId, 0, 0, 0, 0.0, ExecType::REJECTED, order.side});
+                return 0;
+            }
+            emit(ExecutionReport{order.orderId, 0, 0, order.quantity, 0.0, ExecType::NEW, order.side});
+
+            const uint32_t book = bookFor(order.symbol);
+            const int remaining = match(order, book, order.quantity);
+            if (remaining > 0) {
+                if (order.orderType == OrderType::MARKET) {
+                    emit(ExecutionReport{order.orderId, 0, 0, 0, 0.0, ExecType::CANCELLED, order.side});
+                } else {
+                    rest(order, book, remaining);
+                }
+            }
+            return order.quantity - remaining;
+        }
+
+        // Remove a resting order; returns false if it is not on a book
+        bool cancel(int orderId) {
+            const uint32_t slot = restingIndex.find(orderId);
+            if (slot == OrderIndex::emptySlot) return false;
+            RestingOrder& resting = pool[slot];
+
+            auto& levels = resting.side == Side::BUY ? books[resting.book].bids : books[resting.book].asks;
+            auto level = findLevel(levels, resting.side, resting.price);
+            if (resting.prev != nullSlot) {
+                pool[resting.prev].next = resting.next;
+            } else {
+                level->head = resting.next;
+            }
+            if (resting.next != nullSlot) {
+                pool[resting.next].prev = resting.prev;
+            } else {
+                level->tail = resting.prev;
+            }
+            level->totalQuantity -= resting.quantity;
+            if (level->head == nullSlot) {
+                levels.erase(level);
+            }
+
+            emit(ExecutionReport{orderId, 0, 0, 0, 0.0, ExecType::CANCELLED, resting.side});
+            restingIndex.erase(orderId);
+            restingCount--;
+            release(slot);
+            return true;
+        }
+
+        // Best resting price on one side of a symbol's book, if any
+        std::optional<double> bestPrice(Symbol symbol, Side side) const {
+            auto it = bookIds.find(symbol.key());
+            if (it == bookIds.end()) return std::nullopt;
+            const auto& levels = side == Side::BUY ? books[it->second].bids : books[it->second].asks;
+            if (levels.empty()) return std::nullopt;
+            return levels.back().price;
+        }
+
+        // Price of the most recent fill for a symbol, if it has traded
+        std::optional<double> lastTradePrice(Symbol symbol) const {
+            auto it = bookIds.find(symbol.key());
+            if (it == bookIds.end() || books[it->second].lastTradePrice == 0.0) return std::nullopt;
+            return books[it->second].lastTradePrice;
+        }
+
+        std::size_t restingOrderCount() const {
+            return restingCount;
+        }
+};
+
+#endif
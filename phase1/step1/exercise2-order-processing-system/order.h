@@ -0,0 +1,164 @@
+#ifndef ORDER_H
+#define ORDER_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+enum class OrderType: char {
+    MARKET = 'M',
+    LIMIT = 'L',
+    STOP = 'S'
+};
+
+enum class Side: char {
+    BUY = 'B',
+    SELL = 'S'
+};
+
+// Where an order is in its lifecycle; see order_lifecycle.h for the transitions
+enum class OrderStatus: uint8_t {
+    NEW,
+    ACKNOWLEDGED,
+    PARTIALLY_FILLED,
+    FILLED,
+    CANCELLED,
+    REJECTED,
+    TRIGGERED
+};
+
+// Ticker of up to 8 chars stored inline and zero padded. Equality and
+// hashing use the 8 bytes as one 64-bit integer, so comparing two symbols is
+// a single integer compare with no string operations.
+struct Symbol {
+    char chars[8] = {};
+
+    constexpr Symbol() = default;
+
+    constexpr Symbol(std::string_view text) {
+        if (text.length() > 8) {
+            throw std::invalid_argument("Symbol must be 8 chars max");
+        }
+        for (std::size_t i = 0; i < text.length(); i++) {
+            chars[i] = text[i];
+        }
+    }
+
+    constexpr Symbol(const char* text) : Symbol(std::string_view(text)) {}
+
+    Symbol(const std::string& text) : Symbol(std::string_view(text)) {}
+
+    // The 8 bytes as one integer, for comparison and hashing
+    constexpr uint64_t key() const {
+        return std::bit_cast<uint64_t>(chars);
+    }
+
+    constexpr std::size_t length() const {
+        std::size_t n = 0;
+        while (n < 8 && chars[n] != '\0') n++;
+        return n;
+    }
+
+    constexpr std::string_view view() const {
+        return std::string_view(chars, length());
+    }
+
+    constexpr bool operator==(const Symbol& other) const {
+        return key() == other.key();
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& out, const Symbol& symbol) {
+    return out << symbol.view();
+}
+
+// Why an order was rejected, in the order the checks are applied
+enum class OrderError: char {
+    INVALID_TYPE,
+    INVALID_SIDE,
+    INVALID_PRICE,
+    INVALID_QUANTITY,
+    SYMBOL_TOO_LONG
+};
+
+inline const char* toString(OrderError error) {
+    switch (error) {
+        case OrderError::INVALID_TYPE:
+            return "Invalid order type";
+        case OrderError::INVALID_SIDE:
+            return "Invalid side";
+        case OrderError::INVALID_PRICE:
+            return "Price must be positive";
+        case OrderError::INVALID_QUANTITY:
+            return "Quantity must be between 1 and 100000";
+        case OrderError::SYMBOL_TOO_LONG:
+            return "Symbol must be 8 chars max";
+    }
+    return "Unknown order error";
+}
+
+// Plain 32-byte record: no heap pointers, so orders can be memcpy'd into
+// queues, shared memory and binary files as they are.
+struct Order {
+    int orderId;
+    int quantity;
+    double price;
+    Symbol symbol;
+    OrderType orderType;
+    Side side;
+    OrderStatus status;  // Fits in what would otherwise be padding
+
+    // Empty order, e.g. as a target for memcpy
+    Order() = default;
+
+    // Convenience constructor for trusted input; throws std::invalid_argument
+    // with the message for the first failed check
+    Order(int id, std::string_view sym, int qty, double prc, OrderType type, Side sd = Side::BUY) {
+        const std::expected<Order, OrderError> order = create(id, sym, qty, prc, type, sd);
+        if (!order) {
+            throw std::invalid_argument(toString(order.error()));
+        }
+        *this = *order;
+    }
+
+    // Validate without throwing, for the gateway hot path where rejects are
+    // common. Every check is evaluated into one bit of a mask, so a valid
+    // order costs a single branch and a reject reports the first failed check
+    // in the same order the constructor uses.
+    static std::expected<Order, OrderError> create(int id, std::string_view sym, int qty, double prc,
+                                                   OrderType type, Side sd = Side::BUY) {
+        const char t = static_cast<char>(type);
+        const char d = static_cast<char>(sd);
+        const unsigned failures =
+            static_cast<unsigned>((t != 'M') & (t != 'L') & (t != 'S')) |
+            static_cast<unsigned>((d != 'B') & (d != 'S')) << 1 |
+            static_cast<unsigned>(!(prc > 0)) << 2 |  // Also rejects NaN
+            static_cast<unsigned>(static_cast<unsigned>(qty) - 1u >= 100000u) << 3 |
+            static_cast<unsigned>(sym.length() > 8) << 4;
+        if (failures != 0) [[unlikely]] {
+            return std::unexpected(static_cast<OrderError>(std::countr_zero(failures)));
+        }
+        Order order;
+        order.orderId = id;
+        order.quantity = qty;
+        order.price = prc;
+        order.symbol = Symbol(sym);
+        order.orderType = type;
+        order.side = sd;
+        order.status = OrderStatus::NEW;
+        return order;
+    }
+};
+
+static_assert(sizeof(Symbol) == 8, "Symbol is one 64-bit word");
+static_assert(sizeof(Order) == 32, "Order packs into half a cache line");
+static_assert(std::is_trivially_copyable_v<Order>, "Order is copied as raw bytes");
+static_assert(std::is_standard_layout_v<Order>, "Order has a fixed, C-compatible layout");
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef ORDER_INDEX_H
+#define ORDER_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Maps an int order id to a 32-bit storage slot. The system, the matching
+// engine and the stop engine each keep one, for their own slots.
+//
+// Entries are 8 bytes, eight to a cache line, kept in one power-of-two array
+// and probed linearly. erase() shifts the rest of the probe run back instead
+// of leaving tombstones, so lookups stay short however many orders have been
+// cancelled. The array doubles once it is half full; reserve() up front and
+// inserts never allocate.
+class OrderIndex {
+    private:
+        struct Entry {
+            int id;
+            uint32_t slot;  // emptySlot marks an unused entry
+        };
+
+        std::vector<Entry> table;
+        std::size_t mask = 0;
+        std::size_t count = 0;
+
+        // Finalizer from MurmurHash3: sequential ids spread over the whole table
+        static std::size_t hash(int id) {
+            uint32_t h = static_cast<uint32_t>(id);
+            h ^= h >> 16;
+            h *= 0x85ebca6bU;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35U;
+            h ^= h >> 16;
+            return h;
+        }
+
+        void rehash(std::size_t capacity) {
+            std::vector<Entry> old;
+            old.swap(table);
+            table.assign(capacity, Entry{0, emptySlot});
+            mask = capacity - 1;
+            count = 0;
+            for (const auto& entry : old) {
+                if (entry.slot != emptySlot) insert(entry.id, entry.slot);
+            }
+        }
+
+    public:
+        static constexpr uint32_t emptySlot = UINT32_MAX;
+
+        explicit OrderIndex(std::size_t expected = 1024) {
+            reserve(expected);
+        }
+
+        // Size the table so `expected` ids fit without growing
+        void reserve(std::size_t expected) {
+            std::size_t capacity = 16;
+            while (capacity < expected * 2) capacity <<= 1;
+            if (capacity > table.size()) rehash(capacity);
+        }
+
+        // Slot for `id`, or emptySlot
+        uint32_t find(int id) const {
+            for (std::size_t i = hash(id) & mask;; i = (i + 1) & mask) {
+                const Entry& entry = table[i];
+                if (entry.slot == emptySlot) return emptySlot;
+                if (entry.id == id) return entry.slot;
+            }
+        }
+
+        // Returns false if `id` is already present
+        bool insert(int id, uint32_t slot) {
+            if ((count + 1) * 2 > table.size()) rehash(table.size() * 2);
+            for (std::size_t i = hash(id) & mask;; i = (i + 1) & mask) {
+                Entry& entry = table[i];
+                if (entry.slot == emptySlot) {
+                    entry = Entry{id, slot};
+                    count++;
+                    return true;
+                }
+                if (entry.id == id) return false;
+            }
+        }
+
+        // Returns false if `id` was not present
+        bool erase(int id) {
+            std::size_t i = hash(id) & mask;
+            for (;; i = (i + 1) & mask) {
+                if (table[i].slot == emptySlot) return false;
+                if (table[i].id == id) break;
+            }
+            // Shift later entries of the probe run back into the hole
+            for (std::size_t j = (i + 1) & mask;; j = (j + 1) & mask) {
+                if (table[j].slot == emptySlot) break;
+                const std::size_t home = hash(table[j].id) & mask;
+                // Move j into i only if its home is not cyclically in (i, j]
+                const bool between = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+                if (!between) {
+                    table[i] = table[j];
+                    i = j;
+                }
+            }
+            table[i].slot = emptySlot;
+            count--;
+            return true;
+        }
+
+        std::size_t size() const {
+            return count;
+        }
+};
+
+#endif
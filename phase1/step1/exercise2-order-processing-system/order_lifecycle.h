@@ -0,0 +1,108 @@
+#ifndef ORDER_LIFECYCLE_H
+#define ORDER_LIFECYCLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "order.h"
+
+// Something that happens to an order
+enum class OrderEvent: uint8_t {
+    ACKNOWLEDGE,
+    PARTIAL_FILL,
+    FILL,
+    CANCEL,
+    REJECT,
+    TRIGGER
+};
+
+constexpr std::size_t orderStatusCount = 7;
+constexpr std::size_t orderEventCount = 6;
+
+inline const char* toString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::NEW:
+            return "New";
+        case OrderStatus::ACKNOWLEDGED:
+            return "Acknowledged";
+        case OrderStatus::PARTIALLY_FILLED:
+            return "PartiallyFilled";
+        case OrderStatus::FILLED:
+            return "Filled";
+        case OrderStatus::CANCELLED:
+            return "Cancelled";
+        case OrderStatus::REJECTED:
+            return "Rejected";
+        case OrderStatus::TRIGGERED:
+            return "Triggered";
+    }
+    return "Unknown";
+}
+
+// Order lifecycle as a transition table plus per-status counts.
+//
+// transitions[status][event] is the next status, or `illegal`. Applying an
+// event is a table load and a conditional move: an illegal event leaves the
+// status as it is and is counted, with no branch either way. The counts are
+// updated on every transition, so monitoring can read how many orders are in
+// each status without scanning them.
+class OrderLifecycle {
+    private:
+        static constexpr uint8_t illegal = 0xFF;
+        static constexpr uint8_t N = static_cast<uint8_t>(OrderStatus::NEW);
+        static constexpr uint8_t A = static_cast<uint8_t>(OrderStatus::ACKNOWLEDGED);
+        static constexpr uint8_t P = static_cast<uint8_t>(OrderStatus::PARTIALLY_FILLED);
+        static constexpr uint8_t F = static_cast<uint8_t>(OrderStatus::FILLED);
+        static constexpr uint8_t C = static_cast<uint8_t>(OrderStatus::CANCELLED);
+        static constexpr uint8_t R = static_cast<uint8_t>(OrderStatus::REJECTED);
+        static constexpr uint8_t T = static_cast<uint8_t>(OrderStatus::TRIGGERED);
+        static constexpr uint8_t X = illegal;
+
+        // Columns: ACKNOWLEDGE, PARTIAL_FILL, FILL, CANCEL, REJECT, TRIGGER
+        static constexpr std::array<std::array<uint8_t, orderEventCount>, orderStatusCount> transitions = {{
+            /* NEW              */ {A, X, X, C, R, X},
+            /* ACKNOWLEDGED     */ {X, P, F, C, X, T},  // TRIGGER: a pending stop fires
+            /* PARTIALLY_FILLED */ {X, P, F, C, X, X},
+            /* FILLED           */ {X, X, X, X, X, X},
+            /* CANCELLED        */ {X, X, X, X, X, X},
+            /* REJECTED         */ {X, X, X, X, X, X},
+            /* TRIGGERED        */ {T, P, F, C, R, X},  // Matching acknowledges the released order again
+        }};
+
+        std::array<std::size_t, orderStatusCount> counts{};
+        std::size_t illegalCount = 0;
+
+    public:
+        // Start counting a new order in its initial status
+        void track(OrderStatus status) {
+            counts[static_cast<uint8_t>(status)]++;
+        }
+
+        // Move `status` on by `event`. Returns false, leaving `status` unchanged,
+        // if the event is not allowed in the current status.
+        bool apply(OrderStatus& status, OrderEvent event) {
+            const uint8_t from = static_cast<uint8_t>(status);
+            const uint8_t next = transitions[from][static_cast<uint8_t>(event)];
+            const bool legal = next != illegal;
+            const uint8_t to = legal ? next : from;
+            counts[from]--;
+            counts[to]++;
+            illegalCount += !legal;
+            status = static_cast<OrderStatus>(to);
+            return legal;
+        }
+
+        // Orders currently in `status`. Removed orders stay counted in the
+        // status they were removed in.
+        std::size_t count(OrderStatus status) const {
+            return counts[static_cast<uint8_t>(status)];
+        }
+
+        // Events that were refused because the order's status did not allow them
+        std::size_t illegalTransitions() const {
+            return illegalCount;
+        }
+};
+
+#endif
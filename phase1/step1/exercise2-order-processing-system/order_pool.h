@@ -0,0 +1,148 @@
+#ifndef ORDER_POOL_H
+#define ORDER_POOL_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "order.h"
+
+// Stable 32-bit reference to an order stored in an OrderPool: the low 24 bits
+// are the slot, the high 8 bits the slot's generation when it was handed out
+using OrderHandle = uint32_t;
+
+// Slab storage for orders.
+//
+// Orders live in fixed 4096-order chunks (128 KiB, cache-line aligned) that
+// never move, so a reference stays valid until that order is released.
+// Released slots go on a free stack and are reused first, so memory is
+// recycled after cancels. Insert and release are O(1).
+//
+// Each slot has a generation that is bumped when it is released, and every
+// handle carries the generation it was issued with. A stale handle therefore
+// no longer matches its slot once the slot is reused: contains() reports it,
+// and operator[] asserts on it in debug builds. The generation is 8 bits, so
+// a handle held across 256 reuses of its slot would match again.
+//
+// Chunks and the free stack are sized up front for the expected capacity.
+// Going past it adds a chunk and may reallocate the chunk table and the free
+// stack (never the orders themselves).
+class OrderPool {
+    private:
+        static constexpr unsigned chunkBits = 12;
+        static constexpr uint32_t chunkSize = 1u << chunkBits;
+        static constexpr uint32_t chunkMask = chunkSize - 1;
+        static constexpr std::align_val_t chunkAlignment{64};
+        static constexpr unsigned slotBits = 24;
+        static constexpr uint32_t slotMask = (1u << slotBits) - 1;
+        // The last slot is never handed out, so no handle equals invalidHandle
+        static constexpr uint32_t maxSlots = slotMask;
+
+        std::vector<Order*> chunks;
+        std::vector<uint8_t> generations;  // Per slot
+        std::vector<uint32_t> freeSlots;
+        uint32_t highWater = 0;  // Slots below this have been handed out at least once
+        std::size_t liveCount = 0;
+
+        void addChunk() {
+            chunks.push_back(static_cast<Order*>(::operator new(sizeof(Order) * chunkSize, chunkAlignment)));
+            generations.resize(chunks.size() * chunkSize, 0);
+        }
+
+        static OrderHandle makeHandle(uint32_t slot, uint8_t generation) {
+            return static_cast<uint32_t>(generation) << slotBits | slot;
+        }
+
+        Order& at(uint32_t slot) {
+            return chunks[slot >> chunkBits][slot & chunkMask];
+        }
+
+        const Order& at(uint32_t slot) const {
+            return chunks[slot >> chunkBits][slot & chunkMask];
+        }
+
+    public:
+        static constexpr OrderHandle invalidHandle = UINT32_MAX;
+
+        explicit OrderPool(std::size_t expectedOrders = 1024) {
+            const std::size_t chunkCount = (expectedOrders + chunkSize - 1) / chunkSize;
+            chunks.reserve(chunkCount);
+            generations.reserve(chunkCount * chunkSize);
+            for (std::size_t i = 0; i < chunkCount; i++) {
+                addChunk();
+            }
+            freeSlots.reserve(expectedOrders);
+        }
+
+        ~OrderPool() {
+            for (Order* chunk : chunks) {
+                ::operator delete(chunk, chunkAlignment);
+            }
+        }
+
+        OrderPool(const OrderPool&) = delete;
+        OrderPool& operator=(const OrderPool&) = delete;
+
+        // Slot index of a handle, e.g. to key per-slot side tables
+        static uint32_t slotOf(OrderHandle handle) {
+            return handle & slotMask;
+        }
+
+        // Copy `order` into a free slot and return its handle
+        OrderHandle allocate(const Order& order) {
+            uint32_t slot;
+            if (!freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            } else {
+                if (highWater == maxSlots) {
+                    throw std::length_error("Order pool is full");
+                }
+                if (highWater == static_cast<uint32_t>(chunks.size()) * chunkSize) {
+                    addChunk();
+                }
+                slot = highWater++;
+            }
+            at(slot) = order;
+            liveCount++;
+            return makeHandle(slot, generations[slot]);
+        }
+
+        // Return a slot for reuse; the handle stops being valid
+        void release(OrderHandle handle) {
+            assert(contains(handle));
+            const uint32_t slot = slotOf(handle);
+            generations[slot]++;
+            freeSlots.push_back(slot);
+            liveCount--;
+        }
+
+        // True if `handle` refers to an order that is still stored
+        bool contains(OrderHandle handle) const {
+            const uint32_t slot = slotOf(handle);
+            return slot < highWater && makeHandle(slot, generations[slot]) == handle;
+        }
+
+        Order& operator[](OrderHandle handle) {
+            assert(contains(handle));
+            return at(slotOf(handle));
+        }
+
+        const Order& operator[](OrderHandle handle) const {
+            assert(contains(handle));
+            return at(slotOf(handle));
+        }
+
+        std::size_t size() const {
+            return liveCount;
+        }
+
+        std::size_t capacity() const {
+            return chunks.size() * chunkSize;
+        }
+};
+
+#endif
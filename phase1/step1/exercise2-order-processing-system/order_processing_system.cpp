@@ -1,98 +1,26 @@
+#include <cstddef>
 #include <iostream>
-#include <string>
-#include <vector>
 
-enum class OrderType: char {
-    MARKET = 'M',
-    LIMIT = 'L',
-    STOP = 'S'
-};
+#include "order.h"
+#include "order_lifecycle.h"
+#include "order_processing_system.h"
+#include "report_sink.h"
 
-struct Order {
-    int orderId;
-    std::string symbol;
-    int quantity;
-    double price;
-    OrderType orderType;
-
-    // Constructor validation
-    // Make sure the orderType is either 'M', 'L', or 'S'
-    Order(int id, const std::string& sym, int qty, double prc, OrderType type)
-        : orderId(id), symbol(sym), quantity(qty), price(prc), orderType(type) {
-        if (type != OrderType::MARKET && type != OrderType::LIMIT && type != OrderType::STOP) {
-            throw std::invalid_argument("Invalid order type");
-        }
-
-        // Check if prise is positive
-        if (prc <= 0) {
-            throw std::invalid_argument("Price must be positive");
-        }
-
-        // Check if quantity is positive
-        if (qty > 100000 || qty < 1) {
-            throw std::invalid_argument("Quantity must be between 1 and 100000");
-        }
-
-        // Symbol must be 8 chars max
-        if (sym.length() > 8) {
-            throw std::invalid_argument("Symbol must be 8 chars max");
-        }
+// Order counts by lifecycle status
+void printStatusCounts(const OrderLifecycle& lifecycle) {
+    std::cout << "  Statuses:";
+    for (std::size_t i = 0; i < orderStatusCount; i++) {
+        const OrderStatus status = static_cast<OrderStatus>(i);
+        std::cout << " " << toString(status) << "=" << lifecycle.count(status);
     }
-};
-
-class OrderProcessingSystem {
-    private:
-        std::vector<Order> orders;
-
-    public:
-        // Use switch case to print order details with modern c++
-        void executeOrder(const Order& order) {
-            switch (order.orderType) {
-                case OrderType::MARKET:
-                    std::cout << "Order ID: " << order.orderId << ", Symbol: " << order.symbol << ", Quantity: " << order.quantity << ", Price: " << order.price << ", Order Type: Market" << std::endl;
-                    break;
-                case OrderType::LIMIT:
-                    std::cout << "Order ID: " << order.orderId << ", Symbol: " << order.symbol << ", Quantity: " << order.quantity << ", Price: " << order.price << ", Order Type: Limit" << std::endl;
-                    break;
-                case OrderType::STOP:
-                    std::cout << "Order ID: " << order.orderId << ", Symbol: " << order.symbol << ", Quantity: " << order.quantity << ", Price: " << order.price << ", Order Type: Stop" << std::endl;
-                    break;
-                default:
-                    std::cout << "Invalid order type" << std::endl;
-                    break;
-            }
-        }
-
-        // Add order to the system
-        void addOrder(const Order& order) {
-            orders.push_back(order);
-        }
-
-        // Get order by id
-        Order getOrderById(int id) {
-            for (const auto& order : orders) {
-                if (order.orderId == id) {
-                    return order;
-                }
-            }
-            throw std::invalid_argument("Order not found");
-        }
-
-        // Get order by symbol
-        Order getOrderBySymbol(const std::string& symbol) {
-            for (const auto& order : orders) {
-                if (order.symbol == symbol) {
-                    return order;
-                }
-            }
-            throw std::invalid_argument("Order not found");
-        }
-};
+    std::cout << ", illegal transitions=" << lifecycle.illegalTransitions() << "\n";
+}
 
 void populateOrders(OrderProcessingSystem& orderProcessingSystem) {
     orderProcessingSystem.addOrder(Order(1, "AAPL", 100, 150.0, OrderType::MARKET));
     orderProcessingSystem.addOrder(Order(2, "GOOG", 200, 2500.0, OrderType::LIMIT));
     orderProcessingSystem.addOrder(Order(3, "MSFT", 300, 350.0, OrderType::STOP));
+    orderProcessingSystem.addOrder(Order(4, "AAPL", 50, 149.5, OrderType::LIMIT));
 }
 
 int main() {
@@ -101,5 +29,49 @@ int main() {
     orderProcessingSystem.executeOrder(orderProcessingSystem.getOrderById(1));
     orderProcessingSystem.executeOrder(orderProcessingSystem.getOrderById(2));
     orderProcessingSystem.executeOrder(orderProcessingSystem.getOrderById(3));
+
+    // Every order for one symbol, without scanning the others
+    for (const Order& order : orderProcessingSystem.getOrdersBySymbol("AAPL")) {
+        orderProcessingSystem.executeOrder(order);
+    }
+    orderProcessingSystem.syncReports();
+
+    // Price-time priority matching: two resting sells, then a buy that sweeps both.
+    // Reports are buffered and synced to std::cout before each summary line.
+    std::cout << "\nMatching:\n";
+    OrderProcessingSystem exchange;
+    TextSink reports(std::cout);
+    exchange.setExecutionListener(&reports);
+    exchange.submitOrder(Order(10, "AAPL", 100, 150.10, OrderType::LIMIT, Side::SELL));
+    exchange.submitOrder(Order(11, "AAPL", 200, 150.20, OrderType::LIMIT, Side::SELL));
+    exchange.submitOrder(Order(12, "AAPL", 250, 150.20, OrderType::LIMIT, Side::BUY));
+    exchange.submitOrder(Order(13, "AAPL", 100, 150.0, OrderType::MARKET, Side::BUY));
+    reports.sync();
+    std::cout << "  Resting orders: " << exchange.getMatchingEngine().restingOrderCount() << "\n";
+
+    // A buy stop at 150.25 fires once a trade prints at 150.30 and lifts the next offer
+    std::cout << "\nStop trigger:\n";
+    exchange.submitOrder(Order(20, "AAPL", 100, 150.30, OrderType::LIMIT, Side::SELL));
+    exchange.submitOrder(Order(21, "AAPL", 100, 150.40, OrderType::LIMIT, Side::SELL));
+    exchange.submitOrder(Order(22, "AAPL", 100, 150.25, OrderType::STOP, Side::BUY));
+    reports.sync();
+    std::cout << "  Pending stops: " << exchange.getStopTriggerEngine().pendingStopCount() << "\n";
+    exchange.submitOrder(Order(23, "AAPL", 50, 150.30, OrderType::LIMIT, Side::BUY));
+    reports.sync();
+    std::cout << "  Pending stops: " << exchange.getStopTriggerEngine().pendingStopCount() << "\n";
+    printStatusCounts(exchange.getLifecycle());
+
+    // Cancels remove the order from the book and every index
+    std::cout << "\nCancels:\n";
+    exchange.submitOrder(Order(30, "MSFT", 100, 349.0, OrderType::LIMIT, Side::BUY));
+    exchange.submitOrder(Order(31, "MSFT", 100, 351.0, OrderType::LIMIT, Side::SELL));
+    exchange.submitOrder(Order(32, "GOOG", 100, 2490.0, OrderType::LIMIT, Side::BUY));
+    exchange.cancelOrder(32);
+    const std::size_t msftCancelled = exchange.cancelSymbol("MSFT");
+    const std::size_t restCancelled = exchange.cancelAll();
+    reports.sync();
+    std::cout << "  Cancelled " << msftCancelled << " MSFT orders, " << restCancelled << " more with cancel-all, "
+              << exchange.orderCount() << " orders left\n";
+    printStatusCounts(exchange.getLifecycle());
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,387 @@
+#ifndef ORDER_PROCESSING_SYSTEM_H
+#define ORDER_PROCESSING_SYSTEM_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "execution_report.h"
+#include "matching_engine.h"
+#include "order.h"
+#include "order_index.h"
+#include "order_lifecycle.h"
+#include "order_pool.h"
+#include "report_sink.h"
+#include "stop_trigger_engine.h"
+#include "symbol_index.h"
+
+// All orders for one symbol: a view over their pool handles, valid until the
+// next order is added or removed. Iterates as const Order&.
+class OrderRange {
+    private:
+        const OrderPool* orders;
+        std::span<const OrderHandle> handles;
+
+    public:
+        class iterator {
+            private:
+                const OrderPool* orders;
+                const OrderHandle* handle;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Order;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Order*;
+                using reference = const Order&;
+
+                iterator() : orders(nullptr), handle(nullptr) {}
+                iterator(const OrderPool* orders, const OrderHandle* handle) : orders(orders), handle(handle) {}
+
+                reference operator*() const {
+                    return (*orders)[*handle];
+                }
+
+                pointer operator->() const {
+                    return &(*orders)[*handle];
+                }
+
+                iterator& operator++() {
+                    ++handle;
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator previous = *this;
+                    ++handle;
+                    return previous;
+                }
+
+                bool operator==(const iterator& other) const {
+                    return handle == other.handle;
+                }
+        };
+
+        OrderRange(const OrderPool* orders, std::span<const OrderHandle> handles)
+            : orders(orders), handles(handles) {}
+
+        iterator begin() const {
+            return iterator(orders, handles.data());
+        }
+
+        iterator end() const {
+            return iterator(orders, handles.data() + handles.size());
+        }
+
+        std::size_t size() const {
+            return handles.size();
+        }
+
+        bool empty() const {
+            return handles.empty();
+        }
+
+        const Order& front() const {
+            return (*orders)[handles.front()];
+        }
+};
+
+// Receives the matching engine's reports to keep each stored order's status
+// current, then passes them on to the caller's listener. An order is stored
+// while it is live: once a report leaves it Filled, Cancelled or Rejected it
+// is dropped from every index and its pool slot is reused.
+//
+// Reports are delivered while matching is still walking the book, so the
+// caller's listener must not call back into the system to add, submit or
+// cancel orders (asserted in debug builds); queue such requests and make
+// them after the call that produced the reports returns.
+class OrderProcessingSystem : private ExecutionListener {
+    private:
+        OrderPool orders;
+        OrderIndex idIndex;         // orderId -> handle in `orders`
+        SymbolIndex symbolIndex;    // symbol -> handles of its orders
+        MatchingEngine engine;
+        StopTriggerEngine stops;
+        std::vector<Order> triggeredStops;  // Scratch for releaseStops
+        // Lowest and highest fill price since stops were last checked; low > high when nothing traded
+        double printLow = std::numeric_limits<double>::infinity();
+        double printHigh = -std::numeric_limits<double>::infinity();
+        OrderLifecycle lifecycle;
+        ExecutionListener* listener = nullptr;
+        bool dispatching = false;  // Inside the caller's listener
+        TextSink defaultSink{std::cout};
+        ReportSink* sink = &defaultSink;
+
+        static OrderEvent toEvent(ExecType execType) {
+            switch (execType) {
+                case ExecType::NEW:
+                    return OrderEvent::ACKNOWLEDGE;
+                case ExecType::PARTIAL_FILL:
+                    return OrderEvent::PARTIAL_FILL;
+                case ExecType::FILL:
+                    return OrderEvent::FILL;
+                case ExecType::CANCELLED:
+                    return OrderEvent::CANCEL;
+                case ExecType::REJECTED:
+                    break;
+            }
+            return OrderEvent::REJECT;
+        }
+
+        void onExecution(const ExecutionReport& report) override {
+            if (report.contraOrderId != 0) {
+                printLow = std::min(printLow, report.lastPrice);
+                printHigh = std::max(printHigh, report.lastPrice);
+            }
+            const OrderHandle handle = findHandle(report.orderId);
+            if (handle != OrderPool::invalidHandle) {
+                OrderStatus& status = orders[handle].status;
+                lifecycle.apply(status, toEvent(report.execType));
+                if (isTerminal(status)) {
+                    retire(report.orderId, handle);
+                }
+            }
+            if (listener != nullptr) {
+                dispatching = true;
+                listener->onExecution(report);
+                dispatching = false;
+            }
+        }
+
+        void resetPrints() {
+            printLow = std::numeric_limits<double>::infinity();
+            printHigh = -std::numeric_limits<double>::infinity();
+        }
+
+        static bool isTerminal(OrderStatus status) {
+            return status == OrderStatus::FILLED || status == OrderStatus::CANCELLED ||
+                   status == OrderStatus::REJECTED;
+        }
+
+        // Drop a finished order from every index and free its slot
+        void retire(int orderId, OrderHandle handle) {
+            symbolIndex.remove(symbolIndex.find(orders[handle].symbol), handle);
+            idIndex.erase(orderId);
+            orders.release(handle);
+        }
+
+        // Pull a live order off its book or the pending stops. Every path ends
+        // in a CANCELLED report, and onExecution retires the order on it.
+        void cancelLive(int orderId, OrderHandle handle) {
+            if (engine.cancel(orderId)) return;
+            stops.cancel(orderId);  // Orders only stored with addOrder are in neither
+            onExecution(ExecutionReport{orderId, 0, 0, 0, 0.0, ExecType::CANCELLED, orders[handle].side});
+        }
+
+        std::size_t cancelSymbolId(SymbolId symbol) {
+            std::size_t count = 0;
+            // Each cancel retires the order, which takes it off the symbol's list
+            for (auto handles = symbolIndex.handlesFor(symbol); !handles.empty();
+                 handles = symbolIndex.handlesFor(symbol)) {
+                const OrderHandle handle = handles.back();
+                cancelLive(orders[handle].orderId, handle);
+                count++;
+            }
+            return count;
+        }
+
+    public:
+        explicit OrderProcessingSystem(std::size_t expectedOrders = 1024)
+            : orders(expectedOrders), idIndex(expectedOrders), symbolIndex(expectedOrders),
+              engine(expectedOrders), stops(expectedOrders) {
+            engine.setExecutionListener(this);
+        }
+
+        OrderProcessingSystem(const OrderProcessingSystem&) = delete;
+        OrderProcessingSystem& operator=(const OrderProcessingSystem&) = delete;
+
+        // Listener receives every execution report; nullptr disables forwarding
+        void setExecutionListener(ExecutionListener* executionListener) {
+            listener = executionListener;
+        }
+
+        // Write the order's details to the report sink. The default sink buffers
+        // text for std::cout and writes it on a background thread, so this is a
+        // few memcpys rather than a flushed write.
+        void executeOrder(const Order& order) {
+            sink->writeOrder(order);
+        }
+
+        // Where executeOrder writes; nullptr restores the default text sink
+        void setReportSink(ReportSink* reportSink) {
+            sink = reportSink != nullptr ? reportSink : &defaultSink;
+        }
+
+        // Hand buffered output to the sink's writer thread without waiting for it
+        void flushReports() {
+            sink->flush();
+        }
+
+        // Flush and wait until the stream has every report, e.g. before
+        // printing to the same stream
+        void syncReports() {
+            sink->sync();
+        }
+
+        // Add order to the system; ids must be unique among live orders. Returns its pool handle.
+        OrderHandle addOrder(const Order& order) {
+            assert(!dispatching && "execution listeners must not add orders");
+            if (idIndex.find(order.orderId) != OrderIndex::emptySlot) {
+                throw std::invalid_argument("Duplicate order id");
+            }
+            const OrderHandle handle = orders.allocate(order);
+            orders[handle].status = OrderStatus::NEW;
+            lifecycle.track(OrderStatus::NEW);
+            idIndex.insert(order.orderId, handle);
+            symbolIndex.add(symbolIndex.intern(order.symbol), handle);
+            return handle;
+        }
+
+        // Store the order and match it against its symbol's book; STOP orders
+        // wait until a trade reaches their price. Returns the quantity the
+        // order filled immediately.
+        int submitOrder(const Order& order) {
+            assert(!dispatching && "execution listeners must not submit orders");
+            addOrder(order);
+            resetPrints();
+            if (order.orderType == OrderType::STOP) {
+                stops.add(order);
+                onExecution(ExecutionReport{order.orderId, 0, 0, order.quantity, 0.0, ExecType::NEW, order.side});
+                // A stop whose price has already traded fires straight away
+                if (const std::optional<double> last = engine.lastTradePrice(order.symbol)) {
+                    printLow = *last;
+                    printHigh = *last;
+                    releaseStops(order.symbol);
+                }
+                return 0;
+            }
+            const int filled = engine.submit(order);
+            releaseStops(order.symbol);
+            return filled;
+        }
+
+        // Trigger stops against every price printed since the last check, not
+        // just the last one: a sweep through several levels can pass a stop
+        // and end beyond it. Buy stops fire up to the highest print, sell stops
+        // down to the lowest. Triggered stops go to matching as market orders,
+        // and their fills are checked in the next round until none fire.
+        void releaseStops(Symbol symbol) {
+            while (printLow <= printHigh) {
+                triggeredStops.clear();
+                stops.onTrade(symbol, printHigh, triggeredStops);
+                stops.onTrade(symbol, printLow, triggeredStops);
+                resetPrints();
+                for (const Order& triggered : triggeredStops) {
+                    // Skip a stop that is no longer stored, should a listener have cancelled it
+                    const OrderHandle handle = findHandle(triggered.orderId);
+                    if (handle == OrderPool::invalidHandle) continue;
+                    lifecycle.apply(orders[handle].status, OrderEvent::TRIGGER);
+                    engine.submit(triggered);
+                }
+            }
+        }
+
+        // Cancel a live order and remove it from every index, reusing its slot.
+        // It gets a CANCELLED report. O(1) apart from finding the order's price
+        // level. Returns false if the id is unknown or the order already finished.
+        bool cancelOrder(int orderId) {
+            assert(!dispatching && "execution listeners must not cancel orders");
+            const OrderHandle handle = findHandle(orderId);
+            if (handle == OrderPool::invalidHandle) return false;
+            cancelLive(orderId, handle);
+            return true;
+        }
+
+        // Cancel every live order for a symbol in O(k); returns how many were cancelled
+        std::size_t cancelSymbol(Symbol symbol) {
+            assert(!dispatching && "execution listeners must not cancel orders");
+            const SymbolId id = symbolIndex.find(symbol);
+            return id == SymbolIndex::invalidId ? 0 : cancelSymbolId(id);
+        }
+
+        // Cancel every live order in the system; returns how many were cancelled
+        std::size_t cancelAll() {
+            assert(!dispatching && "execution listeners must not cancel orders");
+            std::size_t count = 0;
+            for (SymbolId id = 0; id < symbolIndex.symbolCount(); id++) {
+                count += cancelSymbolId(id);
+            }
+            return count;
+        }
+
+        // Per-status order counts, kept current as reports arrive
+        const OrderLifecycle& getLifecycle() const {
+            return lifecycle;
+        }
+
+        const StopTriggerEngine& getStopTriggerEngine() const {
+            return stops;
+        }
+
+        const MatchingEngine& getMatchingEngine() const {
+            return engine;
+        }
+
+        // Get order by id in O(1). The reference stays valid while the order is stored.
+        const Order& getOrderById(int id) const {
+            const Order* order = findOrderById(id);
+            if (order == nullptr) {
+                throw std::invalid_argument("Order not found");
+            }
+            return *order;
+        }
+
+        // Non-throwing lookup: nullptr if the id is unknown
+        const Order* findOrderById(int id) const {
+            const OrderHandle handle = findHandle(id);
+            return handle == OrderPool::invalidHandle ? nullptr : &orders[handle];
+        }
+
+        // Handle of a stored order, or OrderPool::invalidHandle if the id is unknown
+        OrderHandle findHandle(int id) const {
+            const uint32_t handle = idIndex.find(id);
+            return handle == OrderIndex::emptySlot ? OrderPool::invalidHandle : handle;
+        }
+
+        // Order behind a handle; throws if the order has since been removed
+        const Order& getOrder(OrderHandle handle) const {
+            if (!orders.contains(handle)) {
+                throw std::invalid_argument("Stale order handle");
+            }
+            return orders[handle];
+        }
+
+        // Get the first order in a symbol's index (the oldest, unless orders were removed)
+        const Order& getOrderBySymbol(Symbol symbol) const {
+            OrderRange range = getOrdersBySymbol(symbol);
+            if (range.empty()) {
+                throw std::invalid_argument("Order not found");
+            }
+            return range.front();
+        }
+
+        // All orders for a symbol in O(k) for k matches
+        OrderRange getOrdersBySymbol(Symbol symbol) const {
+            return OrderRange(&orders, symbolIndex.handlesFor(symbolIndex.find(symbol)));
+        }
+
+        // Live orders: added and not yet filled, cancelled or rejected
+        std::size_t orderCount() const {
+            return orders.size();
+        }
+
+        // Slots allocated for orders; stays flat while finished orders free slots for reuse
+        std::size_t orderCapacity() const {
+            return orders.capacity();
+        }
+};
+
+#endif
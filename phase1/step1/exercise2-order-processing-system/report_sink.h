@@ -0,0 +1,286 @@
+#ifndef REPORT_SINK_H
+#define REPORT_SINK_H
+
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "execution_report.h"
+#include "order.h"
+
+// Destination for order and execution output. Sinks buffer in memory; when
+// the buffer fills, or on flush(), it is handed to a background thread that
+// writes it to the stream, so reporting an order never waits on the write.
+// sync() also waits until the stream has everything, e.g. before printing to
+// the same stream from the caller's thread.
+class ReportSink : public ExecutionListener {
+    public:
+        virtual void writeOrder(const Order& order) = 0;
+        virtual void flush() {}
+        virtual void sync() {
+            flush();
+        }
+};
+
+// Double buffering for a sink: the sink fills one buffer while a writer
+// thread writes and flushes the other to the stream. Handing over a buffer
+// only waits if the writer is still busy with the previous one, i.e. when
+// output arrives faster than the stream takes it. The thread starts on the
+// first hand-over, so a sink that never writes costs no thread.
+class AsyncStreamWriter {
+    private:
+        std::ostream& out;
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<char> pending;  // Owned by the writer thread while busy
+        std::size_t pendingBytes = 0;
+        bool busy = false;
+        bool stopping = false;
+        std::thread thread;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                changed.wait(lock, [this] { return busy || stopping; });
+                if (!busy) return;
+                lock.unlock();
+                out.write(pending.data(), static_cast<std::streamsize>(pendingBytes));
+                out.flush();
+                lock.lock();
+                busy = false;
+                changed.notify_all();
+            }
+        }
+
+    public:
+        AsyncStreamWriter(std::ostream& out, std::size_t bufferBytes) : out(out), pending(bufferBytes) {}
+
+        ~AsyncStreamWriter() {
+            if (!thread.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            changed.notify_all();
+            thread.join();  // The writer finishes a pending buffer before it stops
+        }
+
+        AsyncStreamWriter(const AsyncStreamWriter&) = delete;
+        AsyncStreamWriter& operator=(const AsyncStreamWriter&) = delete;
+
+        // Queue the first `used` bytes of `buffer` for writing; `buffer` is
+        // swapped for the writer's spare, which has the same size
+        void submit(std::vector<char>& buffer, std::size_t used) {
+            if (used == 0) return;
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !busy; });
+            buffer.swap(pending);
+            pendingBytes = used;
+            busy = true;
+            if (!thread.joinable()) {
+                thread = std::thread(&AsyncStreamWriter::run, this);
+            }
+            changed.notify_all();
+        }
+
+        // Wait until everything submitted has been written
+        void drain() {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !busy; });
+        }
+};
+
+// Discards everything, e.g. for benchmarks or when nobody is listening
+class NullSink : public ReportSink {
+    public:
+        void writeOrder(const Order&) override {}
+        void onExecution(const ExecutionReport&) override {}
+};
+
+// Human-readable lines, formatted with std::to_chars straight into a buffer:
+//   Order ID: 1, Symbol: AAPL, Quantity: 100, Price: 150, Order Type: Market
+//   Exec 2 order 12 side B filled 100 @ 150.1 vs 10, leaves 0
+// Prices use 6 significant digits like a default std::ostream, so lines match
+// the old std::cout output (150.123456 prints as 150.123, 1e6 as 1e+06).
+class TextSink : public ReportSink {
+    private:
+        static constexpr std::size_t maxLineLength = 160;  // Longest line either writer can produce
+
+        std::vector<char> buffer;
+        std::size_t used = 0;
+        AsyncStreamWriter writer;
+
+        void reserveLine() {
+            if (used + maxLineLength > buffer.size()) {
+                flush();
+            }
+        }
+
+        void append(std::string_view text) {
+            std::memcpy(buffer.data() + used, text.data(), text.size());
+            used += text.size();
+        }
+
+        void append(char c) {
+            buffer[used++] = c;
+        }
+
+        void append(int value) {
+            used = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value).ptr - buffer.data();
+        }
+
+        void append(double value) {
+            used = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value,
+                                 std::chars_format::general, 6).ptr - buffer.data();
+        }
+
+    public:
+        explicit TextSink(std::ostream& out, std::size_t bufferBytes = 64 << 10)
+            : buffer(bufferBytes < maxLineLength ? maxLineLength : bufferBytes), writer(out, buffer.size()) {}
+
+        ~TextSink() override {
+            flush();
+        }
+
+        void writeOrder(const Order& order) override {
+            reserveLine();
+            std::string_view type;
+            switch (order.orderType) {
+                case OrderType::MARKET:
+                    type = "Market";
+                    break;
+                case OrderType::LIMIT:
+                    type = "Limit";
+                    break;
+                case OrderType::STOP:
+                    type = "Stop";
+                    break;
+                default:
+                    append(std::string_view("Invalid order type\n"));
+                    return;
+            }
+            append(std::string_view("Order ID: "));
+            append(order.orderId);
+            append(std::string_view(", Symbol: "));
+            append(order.symbol.view());
+            append(std::string_view(", Quantity: "));
+            append(order.quantity);
+            append(std::string_view(", Price: "));
+            append(order.price);
+            append(std::string_view(", Order Type: "));
+            append(type);
+            append('\n');
+        }
+
+        void onExecution(const ExecutionReport& report) override {
+            reserveLine();
+            append(std::string_view("  Exec "));
+            append(static_cast<char>(report.execType));
+            append(std::string_view(" order "));
+            append(report.orderId);
+            append(std::string_view(" side "));
+            append(static_cast<char>(report.side));
+            if (report.contraOrderId != 0) {
+                append(std::string_view(" filled "));
+                append(report.lastQuantity);
+                append(std::string_view(" @ "));
+                append(report.lastPrice);
+                append(std::string_view(" vs "));
+                append(report.contraOrderId);
+            }
+            append(std::string_view(", leaves "));
+            append(report.leavesQuantity);
+            append('\n');
+        }
+
+        // Hand what is buffered to the writer thread
+        void flush() override {
+            writer.submit(buffer, used);
+            used = 0;
+        }
+
+        void sync() override {
+            flush();
+            writer.drain();
+        }
+};
+
+// Raw records, host byte order: a one-byte tag ('O' or 'E') followed by an
+// Order or ExecutionReport in its in-memory layout (same size and field
+// offsets). Fields are copied one by one into a zeroed record, so padding
+// bytes are always 0 and the same reports give byte-identical files.
+class BinarySink : public ReportSink {
+    private:
+        std::vector<char> buffer;
+        std::size_t used = 0;
+        AsyncStreamWriter writer;
+
+        // Append a tag and `size` zero bytes; returns where the record's fields go
+        char* beginRecord(char tag, std::size_t size) {
+            if (used + 1 + size > buffer.size()) {
+                flush();
+            }
+            buffer[used] = tag;
+            char* record = buffer.data() + used + 1;
+            std::memset(record, 0, size);
+            used += 1 + size;
+            return record;
+        }
+
+        template <typename Field>
+        static void put(char* record, std::size_t offset, const Field& field) {
+            std::memcpy(record + offset, &field, sizeof(Field));
+        }
+
+    public:
+        static constexpr char orderTag = 'O';
+        static constexpr char executionTag = 'E';
+
+        explicit BinarySink(std::ostream& out, std::size_t bufferBytes = 64 << 10)
+            : buffer(bufferBytes < 64 ? 64 : bufferBytes), writer(out, buffer.size()) {}
+
+        ~BinarySink() override {
+            flush();
+        }
+
+        void writeOrder(const Order& order) override {
+            char* record = beginRecord(orderTag, sizeof(Order));
+            put(record, offsetof(Order, orderId), order.orderId);
+            put(record, offsetof(Order, quantity), order.quantity);
+            put(record, offsetof(Order, price), order.price);
+            put(record, offsetof(Order, symbol), order.symbol);
+            put(record, offsetof(Order, orderType), order.orderType);
+            put(record, offsetof(Order, side), order.side);
+            put(record, offsetof(Order, status), order.status);
+        }
+
+        void onExecution(const ExecutionReport& report) override {
+            char* record = beginRecord(executionTag, sizeof(ExecutionReport));
+            put(record, offsetof(ExecutionReport, orderId), report.orderId);
+            put(record, offsetof(ExecutionReport, contraOrderId), report.contraOrderId);
+            put(record, offsetof(ExecutionReport, lastQuantity), report.lastQuantity);
+            put(record, offsetof(ExecutionReport, leavesQuantity), report.leavesQuantity);
+            put(record, offsetof(ExecutionReport, lastPrice), report.lastPrice);
+            put(record, offsetof(ExecutionReport, execType), report.execType);
+            put(record, offsetof(ExecutionReport, side), report.side);
+        }
+
+        // Hand what is buffered to the writer thread
+        void flush() override {
+            writer.submit(buffer, used);
+            used = 0;
+        }
+
+        void sync() override {
+            flush();
+            writer.drain();
+        }
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef STOP_TRIGGER_ENGINE_H
+#define STOP_TRIGGER_ENGINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "order.h"
+#include "order_index.h"
+
+// Pending STOP orders, released when the traded price reaches them.
+//
+// A buy stop triggers once a trade prints at or above its price, a sell stop
+// once a trade prints at or below. Each symbol keeps its stops grouped by
+// trigger price in two vectors sorted so the next level to trigger is back():
+// descending for buys, ascending for sells. A trade pops levels from the back
+// until the first untriggered price, so releasing k stops costs O(k) no matter
+// how many stay pending. Adding a new trigger price shifts only the levels
+// closer to the market than it. Stops at one trigger price keep their arrival
+// order and are released oldest first.
+//
+// Like MatchingEngine, pending stops live in one pool recycled through a free
+// list, and the pool, id index and level vectors are reserved up front, so
+// parking and releasing stops do not allocate; only the first stop for a new
+// symbol creates its book.
+class StopTriggerEngine {
+    private:
+        static constexpr uint32_t nullSlot = UINT32_MAX;
+
+        struct PendingStop {
+            Order order;
+            uint32_t book;
+            uint32_t prev;
+            uint32_t next;  // Free list link when unused
+        };
+
+        struct TriggerLevel {
+            double trigger;
+            uint32_t head;  // Oldest stop, first to release
+            uint32_t tail;
+        };
+
+        struct StopBook {
+            std::vector<TriggerLevel> buys;   // Highest to lowest trigger
+            std::vector<TriggerLevel> sells;  // Lowest to highest trigger
+        };
+
+        std::vector<PendingStop> pool;
+        uint32_t freeList = nullSlot;
+        std::size_t pendingCount = 0;
+        OrderIndex pendingIndex;  // orderId -> pool slot
+        std::vector<StopBook> books;
+        std::unordered_map<uint64_t, uint32_t> bookIds;  // Symbol key -> book
+        std::size_t levelsPerSide;
+
+        uint32_t allocate(const Order& order, uint32_t book) {
+            uint32_t slot;
+            if (freeList != nullSlot) {
+                slot = freeList;
+                freeList = pool[slot].next;
+                pool[slot].order = order;
+            } else {
+                slot = static_cast<uint32_t>(pool.size());
+                pool.push_back(PendingStop{order, book, nullSlot, nullSlot});
+            }
+            pool[slot].book = book;
+            pool[slot].prev = nullSlot;
+            pool[slot].next = nullSlot;
+            return slot;
+        }
+
+        void release(uint32_t slot) {
+            pool[slot].next = freeList;
+            freeList = slot;
+        }
+
+        // First level in `levels` that triggers no later than `trigger`
+        static std::vector<TriggerLevel>::iterator findLevel(std::vector<TriggerLevel>& levels, Side side,
+                                                             double trigger) {
+            return std::lower_bound(levels.begin(), levels.end(), trigger,
+                                    [side](const TriggerLevel& level, double t) {
+                                        return side == Side::BUY ? level.trigger > t : level.trigger < t;
+                                    });
+        }
+
+        void append(std::vector<TriggerLevel>& levels, Side side, double trigger, uint32_t slot) {
+            auto it = findLevel(levels, side, trigger);
+            if (it == levels.end() || it->trigger != trigger) {
+                it = levels.insert(it, TriggerLevel{trigger, nullSlot, nullSlot});
+            }
+            TriggerLevel& level = *it;
+            pool[slot].prev = level.tail;
+            if (level.tail != nullSlot) {
+                pool[level.tail].next = slot;
+            } else {
+                level.head = slot;
+            }
+            level.tail = slot;
+        }
+
+        // Release every level from back() while `reached(trigger)` holds
+        template <typename Reached>
+        void releaseLevels(std::vector<TriggerLevel>& levels, Reached reached, std::vector<Order>& triggered) {
+            while (!levels.empty() && reached(levels.back().trigger)) {
+                for (uint32_t slot = levels.back().head; slot != nullSlot;) {
+                    const uint32_t next = pool[slot].next;
+                    Order order = pool[slot].order;
+                    order.orderType = OrderType::MARKET;
+                    triggered.push_back(order);
+                    pendingIndex.erase(order.orderId);
+                    pendingCount--;
+                    release(slot);
+                    slot = next;
+                }
+                levels.pop_back();
+            }
+        }
+
+    public:
+        explicit StopTriggerEngine(std::size_t expectedStops = 1024, std::size_t levelsPerSide = 256)
+            : pendingIndex(expectedStops), levelsPerSide(levelsPerSide) {
+            pool.reserve(expectedStops);
+        }
+
+        // Park a STOP order until its price trades; its price is the trigger
+        void add(const Order& order) {
+            if (order.orderType != OrderType::STOP) {
+                throw std::invalid_argument("Only STOP orders can be parked");
+            }
+            if (pendingIndex.find(order.orderId) != OrderIndex::emptySlot) {
+                throw std::invalid_argument("Duplicate order id");
+            }
+            auto [it, inserted] = bookIds.try_emplace(order.symbol.key(), static_cast<uint32_t>(books.size()));
+            if (inserted) {
+                books.emplace_back();
+                books.back().buys.reserve(levelsPerSide);
+                books.back().sells.reserve(levelsPerSide);
+            }
+            const uint32_t slot = allocate(order, it->second);
+            pendingIndex.insert(order.orderId, slot);
+            pendingCount++;
+            StopBook& book = books[it->second];
+            append(order.side == Side::BUY ? book.buys : book.sells, order.side, order.price, slot);
+        }
+
+        // Remove a pending stop; returns false if it is not pending
+        bool cancel(int orderId) {
+            const uint32_t slot = pendingIndex.find(orderId);
+            if (slot == OrderIndex::emptySlot) return false;
+            PendingStop& stop = pool[slot];
+            StopBook& book = books[stop.book];
+
+            auto unlink = [&](std::vector<TriggerLevel>& levels) {
+                auto it = findLevel(levels, stop.order.side, stop.order.price);
+                TriggerLevel& level = *it;
+                if (stop.prev != nullSlot) {
+                    pool[stop.prev].next = stop.next;
+                } else {
+                    level.head = stop.next;
+                }
+                if (stop.next != nullSlot) {
+                    pool[stop.next].prev = stop.prev;
+                } else {
+                    level.tail = stop.prev;
+                }
+                if (level.head == nullSlot) {
+                    levels.erase(it);
+                }
+            };
+            if (stop.order.side == Side::BUY) {
+                unlink(book.buys);
+            } else {
+                unlink(book.sells);
+            }
+            pendingIndex.erase(orderId);
+            pendingCount--;
+            release(slot);
+            return true;
+        }
+
+        // A trade printed at `price`: append every stop it triggers, converted to
+        // a MARKET order, to `triggered`. Returns how many were released.
+        std::size_t onTrade(Symbol symbol, double price, std::vector<Order>& triggered) {
+            auto it = bookIds.find(symbol.key());
+            if (it == bookIds.end()) return 0;
+            const std::size_t before = triggered.size();
+            StopBook& book = books[it->second];
+            releaseLevels(book.buys, [price](double trigger) { return trigger <= price; }, triggered);
+            releaseLevels(book.sells, [price](double trigger) { return trigger >= price; }, triggered);
+            return triggered.size() - before;
+        }
+
+        std::size_t pendingStopCount() const {
+            return pendingCount;
+        }
+};
+
+#endif
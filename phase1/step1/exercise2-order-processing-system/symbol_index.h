@@ -0,0 +1,82 @@
+#ifndef SYMBOL_INDEX_H
+#define SYMBOL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "order.h"
+#include "order_pool.h"
+
+// Small integer handle for an interned symbol
+using SymbolId = uint32_t;
+
+// Secondary index from symbol to the pool handles of its orders.
+//
+// Symbols are interned to dense ids the first time they are seen, so the
+// symbol is hashed once per lookup and everything after that is a vector
+// index. Each symbol keeps its order slots in a contiguous vector, which
+// makes "all orders for a symbol" a span walked in O(k). Handles are appended
+// in insertion order; removing one moves the symbol's last handle into its
+// place, so removal is O(1) and order is only kept until the first removal.
+class SymbolIndex {
+    private:
+        std::unordered_map<uint64_t, SymbolId> ids;  // Symbol key -> id
+        std::vector<std::vector<OrderHandle>> handles;  // Indexed by SymbolId
+        std::vector<uint32_t> positions;                 // Pool slot -> index within its symbol's vector
+
+    public:
+        static constexpr SymbolId invalidId = UINT32_MAX;
+
+        explicit SymbolIndex(std::size_t expectedOrders = 1024) {
+            positions.reserve(expectedOrders);
+        }
+
+        // Return the id for `symbol`, assigning the next free id if it is new
+        SymbolId intern(Symbol symbol) {
+            auto [it, inserted] = ids.try_emplace(symbol.key(), static_cast<SymbolId>(handles.size()));
+            if (inserted) {
+                handles.emplace_back();
+            }
+            return it->second;
+        }
+
+        // Id of a known symbol, or invalidId
+        SymbolId find(Symbol symbol) const {
+            auto it = ids.find(symbol.key());
+            return it == ids.end() ? invalidId : it->second;
+        }
+
+        void add(SymbolId symbol, OrderHandle handle) {
+            const uint32_t slot = OrderPool::slotOf(handle);
+            if (slot >= positions.size()) {
+                positions.resize(slot + 1);
+            }
+            positions[slot] = static_cast<uint32_t>(handles[symbol].size());
+            handles[symbol].push_back(handle);
+        }
+
+        // Remove one handle from `symbol` in O(1)
+        void remove(SymbolId symbol, OrderHandle handle) {
+            std::vector<OrderHandle>& symbolHandles = handles[symbol];
+            const uint32_t position = positions[OrderPool::slotOf(handle)];
+            const OrderHandle last = symbolHandles.back();
+            symbolHandles[position] = last;
+            positions[OrderPool::slotOf(last)] = position;
+            symbolHandles.pop_back();
+        }
+
+        // Handles of every order for `symbol`
+        std::span<const OrderHandle> handlesFor(SymbolId symbol) const {
+            if (symbol >= handles.size()) return {};
+            return handles[symbol];
+        }
+
+        std::size_t symbolCount() const {
+            return handles.size();
+        }
+};
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef BAR_BUILDER_H
+#define BAR_BUILDER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "market_types.h"
+
+// One completed OHLCV bar. `start` is aligned to a multiple of `interval`.
+struct Bar {
+    SymbolId symbol;
+    int64_t interval;  // Nanoseconds
+    int64_t start;     // Nanoseconds
+    double open;
+    double high;
+    double low;
+    double close;
+    int64_t volume;
+    double vwap;
+    uint32_t count;
+};
+
+// Receives bars as they complete
+class BarListener {
+public:
+    virtual ~BarListener() = default;
+    virtual void onBar(const Bar& bar) = 0;
+};
+
+// Collects bars in memory
+class BarBuffer : public BarListener {
+private:
+    std::vector<Bar> bars;
+
+public:
+    void onBar(const Bar& bar) override {
+        bars.push_back(bar);
+    }
+
+    const std::vector<Bar>& getBars() const {
+        return bars;
+    }
+
+    void clear() {
+        bars.clear();
+    }
+};
+
+// High, low and sums of a run of consecutive ticks
+struct TickRun {
+    double high;
+    double low;
+    double priceVolume;
+    int64_t volume;
+};
+
+// Reduce n > 0 ticks held in columns: AVX2 (4 ticks per step) when compiled
+// with -mavx2, otherwise SSE2 (2 per step). Min and max are exact in any
+// order; price * volume is summed per lane, so it can differ from a
+// tick-by-tick sum in the last bits.
+inline TickRun reduceTickRun(const double* prices, const int* volumes, std::size_t n) {
+    TickRun run{prices[0], prices[0], 0.0, 0};
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    __m256d high = _mm256_set1_pd(prices[0]);
+    __m256d low = high;
+    __m256d priceVolume = _mm256_setzero_pd();
+    __m256i volume = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+        const __m256d p = _mm256_loadu_pd(prices + i);
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(volumes + i));
+        high = _mm256_max_pd(high, p);
+        low = _mm256_min_pd(low, p);
+        priceVolume = _mm256_add_pd(priceVolume, _mm256_mul_pd(p, _mm256_cvtepi32_pd(v)));
+        volume = _mm256_add_epi64(volume, _mm256_cvtepi32_epi64(v));
+    }
+    alignas(32) double highLanes[4];
+    alignas(32) double lowLanes[4];
+    alignas(32) double pvLanes[4];
+    alignas(32) int64_t volLanes[4];
+    _mm256_store_pd(highLanes, high);
+    _mm256_store_pd(lowLanes, low);
+    _mm256_store_pd(pvLanes, priceVolume);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(volLanes), volume);
+    for (int lane = 0; lane < 4; lane++) {
+        run.high = highLanes[lane] > run.high ? highLanes[lane] : run.high;
+        run.low = lowLanes[lane] < run.low ? lowLanes[lane] : run.low;
+        run.volume += volLanes[lane];
+    }
+    run.priceVolume = (pvLanes[0] + pvLanes[1]) + (pvLanes[2] + pvLanes[3]);
+#elif defined(__SSE2__)
+    __m128d high = _mm_set1_pd(prices[0]);
+    __m128d low = high;
+    __m128d priceVolume = _mm_setzero_pd();
+    for (; i + 2 <= n; i += 2) {
+        const __m128d p = _mm_loadu_pd(prices + i);
+        const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(volumes + i));
+        high = _mm_max_pd(high, p);
+        low = _mm_min_pd(low, p);
+        priceVolume = _mm_add_pd(priceVolume, _mm_mul_pd(p, _mm_cvtepi32_pd(v)));
+        run.volume += static_cast<int64_t>(volumes[i]) + volumes[i + 1];
+    }
+    alignas(16) double highLanes[2];
+    alignas(16) double lowLanes[2];
+    alignas(16) double pvLanes[2];
+    _mm_store_pd(highLanes, high);
+    _mm_store_pd(lowLanes, low);
+    _mm_store_pd(pvLanes, priceVolume);
+    run.high = highLanes[0] > highLanes[1] ? highLanes[0] : highLanes[1];
+    run.low = lowLanes[0] < lowLanes[1] ? lowLanes[0] : lowLanes[1];
+    run.priceVolume = pvLanes[0] + pvLanes[1];
+#endif
+
+    for (; i < n; i++) {
+        run.high = prices[i] > run.high ? prices[i] : run.high;
+        run.low = prices[i] < run.low ? prices[i] : run.low;
+        run.priceVolume += prices[i] * volumes[i];
+        run.volume += volumes[i];
+    }
+    return run;
+}
+
+// Builds bars for several intervals at once from one symbol's ticks.
+// A bar is emitted when the first tick of a later bucket arrives, or on flush().
+// When one tick closes bars of several intervals they are emitted in the
+// order the intervals were given. Timestamps must be non-decreasing.
+class BarBuilder {
+private:
+    struct OpenBar {
+        int64_t interval;
+        int64_t start;
+        int64_t end;  // Exclusive
+        double open;
+        double high;
+        double low;
+        double close;
+        int64_t volume;
+        double priceVolume;
+        uint32_t count;
+    };
+
+    SymbolId symbol;
+    std::vector<OpenBar> bars;
+    BarListener* listener;
+    int64_t flushedUntil = INT64_MIN;  // Ticks before this would reopen a flushed bar
+
+    void emit(const OpenBar& b) {
+        if (b.count == 0 || listener == nullptr) return;
+        const double vwap = b.volume > 0 ? b.priceVolume / static_cast<double>(b.volume) : b.close;
+        listener->onBar(Bar{symbol, b.interval, b.start, b.open, b.high, b.low, b.close, b.volume,
+                            vwap, b.count});
+    }
+
+    // Close the current bar if `timestamp` is past it and start the bucket containing `timestamp`
+    void roll(OpenBar& b, int64_t timestamp) {
+        emit(b);
+        b.start = timestamp - floorMod(timestamp, b.interval);
+        b.end = b.start + b.interval;
+        b.volume = 0;
+        b.priceVolume = 0.0;
+        b.count = 0;
+    }
+
+    static int64_t floorMod(int64_t value, int64_t divisor) {
+        int64_t r = value % divisor;
+        return r < 0 ? r + divisor : r;
+    }
+
+    // Fold a run of ticks that all fall inside the bar's bucket into it
+    static void addRun(OpenBar& b, const TickRun& run, double open, double close, uint32_t count) {
+        if (b.count == 0) {
+            b.open = open;
+            b.high = run.high;
+            b.low = run.low;
+        } else {
+            b.high = run.high > b.high ? run.high : b.high;
+            b.low = run.low < b.low ? run.low : b.low;
+        }
+        b.close = close;
+        b.volume += run.volume;
+        b.priceVolume += run.priceVolume;
+        b.count += count;
+    }
+
+public:
+    BarBuilder(SymbolId symbol, const std::vector<int64_t>& intervals, BarListener* listener)
+        : symbol(symbol), listener(listener) {
+        if (intervals.empty()) {
+            throw std::invalid_argument("At least one interval is required");
+        }
+        for (int64_t interval : intervals) {
+            if (interval <= 0) {
+                throw std::invalid_argument("Interval must be positive");
+            }
+            // An empty bar ending at INT64_MIN forces a roll on the first tick
+            bars.push_back(OpenBar{interval, INT64_MIN, INT64_MIN, 0.0, 0.0, 0.0, 0.0, 0, 0.0, 0});
+        }
+    }
+
+    // Streaming mode: one tick at a time
+    void addTrade(int64_t timestamp, double price, int volume) {
+        assert(timestamp >= flushedUntil && "tick falls in a bar that was already flushed");
+        const TickRun run{price, price, price * volume, volume};
+        for (auto& b : bars) {
+            if (timestamp >= b.end) {
+                roll(b, timestamp);
+            }
+            addRun(b, run, price, price, 1);
+        }
+    }
+
+    void addTrade(const Trade& trade) {
+        addTrade(trade.timestamp, trade.price, trade.volume);
+    }
+
+    // Batch mode for historical data in columnar form, in one pass over the
+    // ticks. Each step rolls the bars the next tick has moved past (in the
+    // same order as addTrade), binary-searches the timestamps for the first
+    // bar boundary, and reduces the ticks before it once with
+    // reduceTickRun. That run lies inside the current bar of every interval,
+    // so all intervals share its result. Bars match streaming mode in content
+    // and order, except that VWAP can differ in the last bits.
+    void addTrades(std::span<const int64_t> timestamps, std::span<const double> prices,
+                   std::span<const int> volumes) {
+        const std::size_t n = timestamps.size();
+        if (prices.size() != n || volumes.size() != n) {
+            throw std::invalid_argument("Column lengths differ");
+        }
+        assert((n == 0 || timestamps[0] >= flushedUntil) && "tick falls in a bar that was already flushed");
+
+        std::size_t i = 0;
+        while (i < n) {
+            int64_t nextEnd = INT64_MAX;
+            for (auto& b : bars) {
+                if (timestamps[i] >= b.end) {
+                    roll(b, timestamps[i]);
+                }
+                nextEnd = b.end < nextEnd ? b.end : nextEnd;
+            }
+            const std::size_t runEnd = static_cast<std::size_t>(
+                std::lower_bound(timestamps.begin() + i, timestamps.end(), nextEnd) - timestamps.begin());
+
+            const TickRun run = reduceTickRun(prices.data() + i, volumes.data() + i, runEnd - i);
+            for (auto& b : bars) {
+                addRun(b, run, prices[i], prices[runEnd - 1], static_cast<uint32_t>(runEnd - i));
+            }
+            i = runEnd;
+        }
+    }
+
+    // Emit every bar that has ticks, e.g. at end of session, and reset to the
+    // constructed state. Later ticks must fall after every flushed bar, or they
+    // would emit a second bar with the same interval and start (asserted).
+    void flush() {
+        for (auto& b : bars) {
+            if (b.count > 0 && b.end > flushedUntil) {
+                flushedUntil = b.end;
+            }
+            emit(b);
+            b.start = INT64_MIN;
+            b.end = INT64_MIN;
+            b.count = 0;
+            b.volume = 0;
+            b.priceVolume = 0.0;
+        }
+    }
+};
+
+// One BarBuilder per symbol, indexed by SymbolId from a BookManager/SymbolTable
+class MultiSymbolBarBuilder {
+private:
+    std::vector<int64_t> intervals;
+    BarListener* listener;
+    std::vector<BarBuilder> builders;
+
+public:
+    MultiSymbolBarBuilder(const std::vector<int64_t>& intervals, BarListener* listener)
+        : intervals(intervals), listener(listener) {}
+
+    // Ids must be dense, as handed out by SymbolTable::intern
+    BarBuilder& builder(SymbolId symbol) {
+        while (builders.size() <= symbol) {
+            builders.emplace_back(static_cast<SymbolId>(builders.size()), intervals, listener);
+        }
+        return builders[symbol];
+    }
+
+    void addTrade(SymbolId symbol, const Trade& trade) {
+        builder(symbol).addTrade(trade);
+    }
+
+    void flush() {
+        for (auto& b : builders) {
+            b.flush();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "market_generator.h"
+#include "price_calculator.h"
+
+// Compare batch snapshot ingest (addBids) with repeated single inserts (addBid)
+
+template <typename Fn>
+double microsPerRun(int runs, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / runs;
+}
+
+int main() {
+    const std::vector<std::size_t> sizes = {64, 128, 256, 1'000, 10'000, 100'000};
+
+    std::cout << std::left << std::setw(10) << "levels" << std::setw(18) << "single us"
+              << std::setw(18) << "batch us" << "speedup\n";
+
+    for (std::size_t size : sizes) {
+        // A snapshot arrives in arbitrary order, not sorted by price
+        MarketConfig config;
+        config.tickSize = 0.0001;
+        MarketGenerator generator(config);
+        std::vector<std::pair<double, int>> snapshot;
+        generator.generateBids(size, snapshot);
+        std::shuffle(snapshot.begin(), snapshot.end(), generator.generator());
+
+        const int runs = size >= 100'000 ? 3 : size <= 1'000 ? 2'000 : 20;
+        std::size_t checkSingle = 0;
+        std::size_t checkBatch = 0;
+
+        double single = microsPerRun(runs, [&] {
+            PriceCalculator calculator(0);
+            for (const auto& level : snapshot) {
+                calculator.addBid(level.first, level.second);
+            }
+            checkSingle = calculator.getBids().size();
+        });
+        double batch = microsPerRun(runs, [&] {
+            PriceCalculator calculator(0);
+            calculator.addBids(snapshot);
+            checkBatch = calculator.getBids().size();
+        });
+
+        if (checkSingle != checkBatch) {
+            std::cerr << "Mismatch: " << checkSingle << " vs " << checkBatch << " levels\n";
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(10) << size << std::fixed << std::setprecision(1)
+                  << std::setw(18) << single << std::setw(18) << batch << single / batch
+                  << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "market_generator.h"
+#include "order_book.h"
+#include "perf_counters.h"
+
+// Counts heap allocations and cache misses per message while replaying a
+// one-million-message L3 feed, for a book sized up front and one that starts
+// empty and grows.
+
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t bytes) {
+    allocationCount++;
+    if (void* pointer = std::malloc(bytes == 0 ? 1 : bytes)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+    allocationCount++;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* pointer = std::aligned_alloc(align, (bytes + align - 1) / align * align)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+static void printCounter(const PerfCounters& counters, PerfCounters::Counter counter, double messages) {
+    if (counters.available(counter)) {
+        std::cout << std::setw(12) << std::setprecision(3) << counters.value(counter) / messages;
+    } else {
+        std::cout << std::setw(12) << "n/a";
+    }
+}
+
+int main() {
+    const std::size_t messageCount = 1'000'000;
+
+    MarketGenerator generator;
+    std::vector<OrderMessage> messages;
+    generator.generateOrderFlow(messageCount, messages);
+
+    struct Sizing {
+        std::string name;
+        std::size_t expectedOrders;
+        std::size_t expectedLevels;
+    };
+    const std::vector<Sizing> sizings = {
+        {"reserved", messageCount / 2, 1024},
+        {"growing", 0, 0},
+    };
+
+    PerfCounters counters;
+    std::cout << "Hardware counters: "
+              << (counters.available(PerfCounters::CacheMisses) ? "available" : "unavailable (timing only)")
+              << "\n";
+    std::cout << std::left << std::setw(10) << "book" << std::right << std::setw(12) << "ns/msg"
+              << std::setw(12) << "allocs/msg" << std::setw(12) << "chunks" << std::setw(12)
+              << "llc/msg" << std::setw(12) << "cyc/msg" << "\n";
+
+    const double total = static_cast<double>(messageCount);
+    for (const auto& sizing : sizings) {
+        OrderBook book(sizing.expectedOrders, sizing.expectedLevels);
+        std::size_t rejected = 0;
+        const std::size_t allocationsBefore = allocationCount;
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& message : messages) {
+            rejected += !book.apply(message);
+        }
+        auto end = std::chrono::steady_clock::now();
+        counters.stop();
+        const std::size_t allocations = allocationCount - allocationsBefore;
+
+        if (rejected != 0) {
+            std::cerr << "Replay rejected " << rejected << " messages\n";
+            return 1;
+        }
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::cout << std::left << std::setw(10) << sizing.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << ns / total << std::setprecision(6)
+                  << std::setw(12) << allocations / total << std::setw(12) << book.chunkAllocations();
+        printCounter(counters, PerfCounters::CacheMisses, total);
+        printCounter(counters, PerfCounters::Cycles, total);
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "book_snapshot.h"
+#include "market_generator.h"
+#include "price_calculator.h"
+
+// Stress test and throughput benchmark for BookSnapshotPublisher: 1 writer, 8 readers
+
+constexpr std::size_t Depth = 10;
+constexpr int readerCount = 8;
+using Publisher = BookSnapshotPublisher<Depth>;
+
+struct ReaderStats {
+    uint64_t reads = 0;
+    uint64_t errors = 0;
+};
+
+// Each check run publishes snapshots whose every field is derived from the
+// version, so a torn read shows up as a field from a different version.
+bool isConsistent(const BookSnapshot<Depth>& s) {
+    if (s.version == 0) return true;
+    if (s.bidCount != Depth || s.askCount != Depth) return false;
+    for (std::size_t i = 0; i < Depth; i++) {
+        const int64_t expected = static_cast<int64_t>(s.version * 16 + i);
+        if (s.bids[i].volume != expected || s.asks[i].volume != expected) return false;
+    }
+    return true;
+}
+
+int main() {
+    const auto duration = std::chrono::seconds(1);
+
+    // 1. Stress: readers validate every snapshot and that versions never go back
+    {
+        Publisher publisher;
+        std::atomic<bool> stop{false};
+        std::vector<ReaderStats> stats(readerCount);
+        std::vector<std::thread> readers;
+        for (int r = 0; r < readerCount; r++) {
+            readers.emplace_back([&, r] {
+                uint64_t lastVersion = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    BookSnapshot<Depth> s = publisher.read();
+                    if (!isConsistent(s) || s.version < lastVersion) stats[r].errors++;
+                    lastVersion = s.version;
+                    stats[r].reads++;
+                }
+            });
+        }
+
+        uint64_t writes = 0;
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {
+            for (int batch = 0; batch < 1000; batch++) {
+                BookSnapshot<Depth> s;
+                const uint64_t version = publisher.version() + 1;
+                s.bidCount = s.askCount = Depth;
+                for (std::size_t i = 0; i < Depth; i++) {
+                    const int64_t tag = static_cast<int64_t>(version * 16 + i);
+                    s.bids[i] = SnapshotLevel{100.0 - i * 0.01, tag};
+                    s.asks[i] = SnapshotLevel{100.01 + i * 0.01, tag};
+                }
+                publisher.publish(s);
+                writes++;
+            }
+        }
+        stop = true;
+        for (auto& reader : readers) reader.join();
+
+        uint64_t reads = 0;
+        uint64_t errors = 0;
+        for (const auto& s : stats) {
+            reads += s.reads;
+            errors += s.errors;
+        }
+        std::cout << "Stress: " << writes << " publishes, " << reads << " reads, " << errors
+                  << " inconsistent snapshots\n";
+        if (errors != 0) return 1;
+    }
+
+    // 2. Throughput: the writer mutates a real book and publishes after every change
+    {
+        PriceCalculator book(1000);
+        Publisher publisher;
+        publisher.publish(book);
+        std::atomic<bool> stop{false};
+        std::vector<ReaderStats> stats(readerCount);
+        std::vector<std::thread> readers;
+        for (int r = 0; r < readerCount; r++) {
+            readers.emplace_back([&, r] {
+                double checksum = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    BookSnapshot<Depth> s = publisher.read();
+                    checksum += s.bids[0].price;
+                    stats[r].reads++;
+                }
+                if (checksum < 0) stats[r].errors++;
+            });
+        }
+
+        // Prices built exactly as the generator built the book, so every add
+        // lands on an existing level instead of a new one an ulp away
+        const MarketConfig config;
+        const std::size_t levelsBefore = book.getBids().size() + book.getAsks().size();
+        Xoshiro256 rng(7);
+        uint64_t writes = 0;
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + duration;
+        while (std::chrono::steady_clock::now() < end) {
+            for (int batch = 0; batch < 1000; batch++) {
+                // Add size to one of the best 10 levels on a random side
+                const double offset = static_cast<double>(1 + rng.nextBelow(10)) * config.tickSize;
+                if (rng.nextBelow(2) == 0) {
+                    book.addBid(config.midPrice - offset, 1);
+                } else {
+                    book.addAsk(config.midPrice + offset, 1);
+                }
+                publisher.publish(book);
+                writes++;
+            }
+        }
+        stop = true;
+        for (auto& reader : readers) reader.join();
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (book.getBids().size() + book.getAsks().size() != levelsBefore) {
+            std::cerr << "Throughput run created new levels\n";
+            return 1;
+        }
+
+        uint64_t reads = 0;
+        for (const auto& s : stats) reads += s.reads;
+        std::cout << "Throughput: " << writes / seconds / 1e6 << " M updates+publishes/s (writer), "
+                  << reads / seconds / 1e6 << " M snapshot reads/s (" << readerCount
+                  << " readers)\n";
+    }
+    return 0;
+}
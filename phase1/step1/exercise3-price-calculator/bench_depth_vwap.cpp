@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "market_generator.h"
+#include "price_calculator.h"
+
+// Compare full-side VWAP with depth-limited and quantity-targeted VWAP on deep books
+
+// Keeps results observable so the optimizer cannot drop the work
+static volatile double sink;
+
+template <typename Fn>
+double nanosPerCall(int iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink = fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main() {
+    const std::vector<int> depths = {1'000, 100'000, 1'000'000};
+
+    std::cout << std::left << std::setw(10) << "levels" << std::setw(16) << "full VWAP ns"
+              << std::setw(16) << "top-10 ns" << std::setw(16) << "fill 50k ns" << "\n";
+
+    for (int depth : depths) {
+        MarketConfig config;
+        config.tickSize = 0.0001;
+        MarketGenerator generator(config);
+        std::vector<std::pair<double, int>> levels;
+
+        PriceCalculator calculator(0);
+        generator.generateBids(depth, levels);
+        for (const auto& level : levels) {
+            calculator.addBid(level.first, level.second);
+        }
+        levels.clear();
+        generator.generateAsks(depth, levels);
+        for (const auto& level : levels) {
+            calculator.addAsk(level.first, level.second);
+        }
+
+        const int iterations = 200;
+        double full = nanosPerCall(iterations, [&] {
+            return calculator.calculateVWAP(calculator.getAsks());
+        });
+        double top = nanosPerCall(iterations * 1000, [&] {
+            return calculator.calculateTopLevelsVWAP(Side::Ask, 10);
+        });
+        double fill = nanosPerCall(iterations * 1000, [&] {
+            return calculator.calculateFillVWAP(Side::Ask, 50'000);
+        });
+
+        std::cout << std::left << std::setw(10) << depth << std::fixed << std::setprecision(1)
+                  << std::setw(16) << full << std::setw(16) << top << std::setw(16) << fill
+                  << "\n";
+    }
+    return 0;
+}
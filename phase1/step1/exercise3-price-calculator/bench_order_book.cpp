@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "market_generator.h"
+#include "order_book.h"
+
+// Replays a synthetic one-million-message L3 feed through OrderBook
+
+int main() {
+    const std::size_t messageCount = 1'000'000;
+    const int runs = 5;
+
+    MarketGenerator generator;
+    std::vector<OrderMessage> messages;
+    generator.generateOrderFlow(messageCount, messages);
+
+    std::size_t counts[4] = {};
+    for (const auto& message : messages) {
+        counts[static_cast<int>(message.type)]++;
+    }
+    std::cout << "Feed: " << counts[0] << " adds, " << counts[1] << " cancels, " << counts[2]
+              << " modifies, " << counts[3] << " executes\n";
+
+    double best = 1e300;
+    for (int run = 0; run < runs; run++) {
+        OrderBook book(messageCount / 2);
+        std::size_t rejected = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& message : messages) {
+            rejected += !book.apply(message);
+        }
+        auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        best = std::min(best, ns);
+
+        if (rejected != 0) {
+            std::cerr << "Replay rejected " << rejected << " messages\n";
+            return 1;
+        }
+        if (run == 0) {
+            std::cout << "Final book: " << book.orderCount() << " orders, "
+                      << book.levelCount(Side::Bid) << " bid levels, " << book.levelCount(Side::Ask)
+                      << " ask levels\n";
+        }
+    }
+
+    std::cout << "Best of " << runs << ": " << best / messageCount << " ns/message, "
+              << messageCount / best * 1e3 << " M messages/s\n";
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "market_generator.h"
+#include "perf_counters.h"
+#include "price_calculator.h"
+#include "vwap_reduction.h"
+
+// Runs every VWAP implementation over working sets sized to L1, L2, L3 and
+// DRAM, reporting ns/element, GB/s and, when perf events are accessible,
+// hardware counters per element.
+//
+// Usage: bench_vwap [max DRAM working set in MiB, default 1024]. The DRAM row
+// needs at least 4x L3 (and 256 MiB) and is skipped if the limit is smaller.
+
+static volatile double sink;
+
+struct Variant {
+    std::string name;
+    std::size_t bytesPerElement;
+    std::function<double()> run;
+};
+
+struct WorkingSet {
+    std::string name;
+    std::size_t bytes;
+};
+
+static std::size_t cacheSize(int name, std::size_t fallback) {
+    long size = sysconf(name);
+    return size > 0 ? static_cast<std::size_t>(size) : fallback;
+}
+
+static void printCounter(const PerfCounters& counters, PerfCounters::Counter counter, double elements) {
+    if (counters.available(counter)) {
+        std::cout << std::setw(10) << std::setprecision(3) << counters.value(counter) / elements;
+    } else {
+        std::cout << std::setw(10) << "n/a";
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::size_t maxDramBytes = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024) << 20;
+
+    // Half of each cache level keeps the working set resident; DRAM is well past L3
+    const std::size_t l1 = cacheSize(_SC_LEVEL1_DCACHE_SIZE, 32 << 10);
+    const std::size_t l2 = cacheSize(_SC_LEVEL2_CACHE_SIZE, 1 << 20);
+    const std::size_t l3 = cacheSize(_SC_LEVEL3_CACHE_SIZE, 32 << 20);
+    std::vector<WorkingSet> sets = {
+        {"L1", l1 / 2},
+        {"L2", l2 / 2},
+        {"L3", l3 / 2},
+    };
+    // Clamping the DRAM set to the limit could put it below L3, so skip it instead
+    const std::size_t dramBytes = std::max<std::size_t>(4 * l3, 256 << 20);
+    if (dramBytes <= maxDramBytes) {
+        sets.push_back({"DRAM", dramBytes});
+    }
+
+    PerfCounters counters;
+    std::cout << "Hardware counters: "
+              << (counters.available(PerfCounters::Cycles) ? "available" : "unavailable (timing only)")
+#if defined(__AVX2__)
+              << ", SIMD: AVX2\n";
+#elif defined(__SSE2__)
+              << ", SIMD: SSE2\n";
+#else
+              << ", SIMD: scalar fallback\n";
+#endif
+    if (dramBytes > maxDramBytes) {
+        std::cout << "Skipping DRAM: needs " << (dramBytes >> 20) << " MiB (4x L3), limit is "
+                  << (maxDramBytes >> 20) << " MiB\n";
+    }
+
+    PriceCalculator calculator(0);
+    for (const auto& set : sets) {
+        // Size by the larger (AoS) layout so both layouts hold the same elements
+        const std::size_t n = std::max<std::size_t>(set.bytes / sizeof(std::pair<double, int>), 64);
+
+        // Fit all n bid levels between half the mid price and the mid price
+        MarketConfig config;
+        config.tickSize = config.midPrice / (2.0 * static_cast<double>(n));
+        MarketGenerator generator(config);
+        std::vector<std::pair<double, int>> levels;
+        generator.generateBids(n, levels);
+        PriceVolumeColumns columns(levels);
+
+        const std::size_t aos = sizeof(std::pair<double, int>);
+        const std::size_t soa = sizeof(double) + sizeof(int);
+        const std::vector<Variant> variants = {
+            {"range-for", aos, [&] { return calculator.calculateVWAP(levels); }},
+            {"pointer", aos, [&] { return calculator.calculateVWAPWithPointers(levels); }},
+            {"compensated", aos, [&] { return calculateVWAPCompensated(levels); }},
+            {"parallel", aos, [&] { return calculateVWAPParallel(levels); }},
+            {"columns", soa, [&] {
+                 return calculateVWAPColumns(columns.prices.data(), columns.volumes.data(), n);
+             }},
+            {"columns-simd", soa, [&] {
+                 return calculateVWAPSimd(columns.prices.data(), columns.volumes.data(), n);
+             }},
+        };
+
+        std::cout << "\n" << set.name << ": " << n << " elements (" << (n * aos >> 10) << " KiB AoS)\n";
+        std::cout << std::left << std::setw(14) << "variant" << std::right << std::setw(10) << "ns/elem"
+                  << std::setw(10) << "GB/s" << std::setw(10) << "cyc/elem" << std::setw(10)
+                  << "ins/elem" << std::setw(10) << "llc/elem" << std::setw(10) << "br/elem"
+                  << "\n";
+
+        // Enough repetitions for roughly 2e8 elements per variant
+        const std::size_t reps = std::max<std::size_t>(3, 200'000'000 / n);
+        for (const auto& variant : variants) {
+            sink = variant.run();  // Warm up caches and page tables
+            counters.start();
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t r = 0; r < reps; r++) {
+                sink = variant.run();
+            }
+            auto end = std::chrono::steady_clock::now();
+            counters.stop();
+
+            const double elements = static_cast<double>(n) * reps;
+            const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            std::cout << std::left << std::setw(14) << variant.name << std::right << std::fixed
+                      << std::setprecision(3) << std::setw(10) << ns / elements << std::setw(10)
+                      << std::setprecision(2) << variant.bytesPerElement * elements / ns;
+            printCounter(counters, PerfCounters::Cycles, elements);
+            printCounter(counters, PerfCounters::Instructions, elements);
+            printCounter(counters, PerfCounters::CacheMisses, elements);
+            printCounter(counters, PerfCounters::BranchMisses, elements);
+            std::cout << "\n";
+        }
+    }
+    return 0;
+}
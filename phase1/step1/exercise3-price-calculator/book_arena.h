@@ -0,0 +1,172 @@
+#ifndef BOOK_ARENA_H
+#define BOOK_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Cache line size assumed for alignment of hot data
+constexpr std::size_t cacheLineSize = 64;
+
+// Fixed-size block allocator: carves cache-line-aligned chunks into equal
+// blocks and recycles freed blocks through an intrusive free list. The block
+// size is fixed by the first allocation, which suits node-based containers
+// that only ever allocate one node type.
+class FixedBlockArena {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::size_t blockSize = 0;
+    std::size_t blocksPerChunk;
+    std::vector<void*> chunks;
+    FreeBlock* freeList = nullptr;
+    std::byte* bump = nullptr;
+    std::size_t bumpLeft = 0;
+    std::size_t reservedBlocks = 0;
+
+    void addChunk(std::size_t blocks) {
+        void* chunk = ::operator new(blocks * blockSize, std::align_val_t{cacheLineSize});
+        chunks.push_back(chunk);
+        bump = static_cast<std::byte*>(chunk);
+        bumpLeft = blocks;
+    }
+
+public:
+    explicit FixedBlockArena(std::size_t blocksPerChunk = 4096) : blocksPerChunk(blocksPerChunk) {}
+
+    ~FixedBlockArena() {
+        for (void* chunk : chunks) {
+            ::operator delete(chunk, std::align_val_t{cacheLineSize});
+        }
+    }
+
+    FixedBlockArena(const FixedBlockArena&) = delete;
+    FixedBlockArena& operator=(const FixedBlockArena&) = delete;
+
+    // Pre-allocate room for `blocks` blocks on the first allocation
+    void reserve(std::size_t blocks) {
+        reservedBlocks = blocks;
+    }
+
+    void* allocate(std::size_t bytes) {
+        if (blockSize == 0) {
+            // Round up so every block keeps 16-byte alignment
+            blockSize = (std::max(bytes, sizeof(FreeBlock)) + 15) & ~std::size_t{15};
+            if (reservedBlocks > 0) addChunk(reservedBlocks);
+        }
+        if (bytes > blockSize) {
+            throw std::bad_alloc();
+        }
+        if (freeList != nullptr) {
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            return block;
+        }
+        if (bumpLeft == 0) {
+            addChunk(blocksPerChunk);
+        }
+        void* block = bump;
+        bump += blockSize;
+        bumpLeft--;
+        return block;
+    }
+
+    void deallocate(void* pointer) {
+        auto* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeList;
+        freeList = block;
+    }
+
+    // Number of times memory was requested from the system
+    std::size_t chunkCount() const {
+        return chunks.size();
+    }
+};
+
+// Standard allocator adapter so node-based containers (std::map, std::list)
+// take their nodes from a FixedBlockArena. Only single-object allocations
+// are supported, which is all node containers need.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    FixedBlockArena* arena;
+
+    explicit ArenaAllocator(FixedBlockArena* arena) : arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        if (n != 1) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(arena->allocate(sizeof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t) {
+        arena->deallocate(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+};
+
+// Array of trivially copyable records addressed by a 32-bit index, stored in
+// cache-line-aligned chunks that never move once allocated.
+template <typename T, unsigned ChunkBits = 12>
+class ChunkedArray {
+    static_assert(std::is_trivially_copyable_v<T>, "ChunkedArray holds plain records");
+
+private:
+    static constexpr uint32_t chunkSize = 1u << ChunkBits;
+    static constexpr uint32_t chunkMask = chunkSize - 1;
+
+    std::vector<T*> chunks;
+
+public:
+    ChunkedArray() = default;
+
+    ~ChunkedArray() {
+        for (T* chunk : chunks) {
+            ::operator delete(chunk, std::align_val_t{cacheLineSize});
+        }
+    }
+
+    ChunkedArray(const ChunkedArray&) = delete;
+    ChunkedArray& operator=(const ChunkedArray&) = delete;
+
+    // Make indices [0, count) valid
+    void ensure(uint32_t count) {
+        while (static_cast<std::size_t>(chunks.size()) * chunkSize < count) {
+            void* chunk = ::operator new(sizeof(T) * chunkSize, std::align_val_t{cacheLineSize});
+            chunks.push_back(static_cast<T*>(chunk));
+        }
+    }
+
+    T& operator[](uint32_t index) {
+        return chunks[index >> ChunkBits][index & chunkMask];
+    }
+
+    const T& operator[](uint32_t index) const {
+        return chunks[index >> ChunkBits][index & chunkMask];
+    }
+
+    uint32_t capacity() const {
+        return static_cast<uint32_t>(chunks.size()) * chunkSize;
+    }
+
+    std::size_t chunkCount() const {
+        return chunks.size();
+    }
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef BOOK_DELTA_H
+#define BOOK_DELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "market_types.h"
+
+// What happened to a price level
+enum class DeltaAction : uint8_t {
+    Add = 'A',     // New level
+    Change = 'C',  // Existing level, new aggregate volume
+    Delete = 'D'   // Level removed
+};
+
+// One incremental L2 update. `volume` is the level's new aggregate volume
+// (0 for Delete), so applying a delta never depends on the previous value.
+struct BookDelta {
+    uint64_t sequence;
+    double price;
+    int32_t volume;
+    DeltaAction action;
+    Side side;
+};
+
+static_assert(std::is_trivially_copyable_v<BookDelta>, "BookDelta is copied as raw bytes");
+
+// Receives deltas as the book mutates
+class BookDeltaListener {
+public:
+    virtual ~BookDeltaListener() = default;
+    virtual void onDelta(const BookDelta& delta) = 0;
+};
+
+// Collects deltas in memory, e.g. to batch them onto the wire
+class BookDeltaBuffer : public BookDeltaListener {
+private:
+    std::vector<BookDelta> deltas;
+
+public:
+    void onDelta(const BookDelta& delta) override {
+        deltas.push_back(delta);
+    }
+
+    const std::vector<BookDelta>& getDeltas() const {
+        return deltas;
+    }
+
+    void clear() {
+        deltas.clear();
+    }
+};
+
+// Wire format, host byte order (little-endian on x86/ARM):
+//   snapshot: "PCBK" | u16 format | u16 reserved | u64 sequence | u32 bids | u32 asks
+//             | levels worst to best as (f64 price, i32 volume), bids then asks
+//   delta:    u64 sequence | f64 price | i32 volume | u8 action | u8 side   (22 bytes)
+namespace bookwire {
+
+constexpr char snapshotMagic[4] = {'P', 'C', 'B', 'K'};
+constexpr uint16_t snapshotFormat = 1;
+constexpr std::size_t snapshotHeaderSize = 4 + 2 + 2 + 8 + 4 + 4;
+constexpr std::size_t levelSize = 8 + 4;
+constexpr std::size_t deltaSize = 8 + 8 + 4 + 1 + 1;
+
+template <typename T>
+inline void put(std::vector<uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+inline T get(std::span<const uint8_t> in, std::size_t& offset) {
+    if (offset + sizeof(T) > in.size()) {
+        throw std::runtime_error("Truncated book data");
+    }
+    T value;
+    std::memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+// Append deltas to `out` in wire format
+inline void encodeDeltas(std::span<const BookDelta> deltas, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + deltas.size() * deltaSize);
+    for (const auto& delta : deltas) {
+        put(out, delta.sequence);
+        put(out, delta.price);
+        put(out, delta.volume);
+        put(out, static_cast<uint8_t>(delta.action));
+        put(out, static_cast<uint8_t>(delta.side));
+    }
+}
+
+// Decode a buffer produced by encodeDeltas. Unknown action or side bytes throw.
+inline std::vector<BookDelta> decodeDeltas(std::span<const uint8_t> in) {
+    if (in.size() % deltaSize != 0) {
+        throw std::runtime_error("Truncated delta stream");
+    }
+    std::vector<BookDelta> deltas;
+    deltas.reserve(in.size() / deltaSize);
+    std::size_t offset = 0;
+    while (offset < in.size()) {
+        BookDelta delta;
+        delta.sequence = get<uint64_t>(in, offset);
+        delta.price = get<double>(in, offset);
+        delta.volume = get<int32_t>(in, offset);
+        const uint8_t action = get<uint8_t>(in, offset);
+        if (action != static_cast<uint8_t>(DeltaAction::Add) && action != static_cast<uint8_t>(DeltaAction::Change) &&
+            action != static_cast<uint8_t>(DeltaAction::Delete)) {
+            throw std::runtime_error("Invalid delta action");
+        }
+        delta.action = static_cast<DeltaAction>(action);
+        uint8_t side = get<uint8_t>(in, offset);
+        if (side > static_cast<uint8_t>(Side::Ask)) {
+            throw std::runtime_error("Invalid delta side");
+        }
+        delta.side = static_cast<Side>(side);
+        deltas.push_back(delta);
+    }
+    return deltas;
+}
+
+}  // namespace bookwire
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef BOOK_MANAGER_H
+#define BOOK_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "market_types.h"
+#include "price_calculator.h"
+
+// Maps symbol strings to dense ids. Strings are only hashed when a symbol is
+// registered or looked up by name; everything after that indexes by id.
+class SymbolTable {
+private:
+    // Transparent hash so find() takes a string_view without building a std::string
+    struct SymbolHash {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view symbol) const {
+            return std::hash<std::string_view>{}(symbol);
+        }
+    };
+
+    std::unordered_map<std::string, SymbolId, SymbolHash, std::equal_to<>> ids;
+    std::vector<std::string> names;
+
+public:
+    static constexpr SymbolId invalidId = UINT32_MAX;
+
+    void reserve(std::size_t symbols) {
+        ids.reserve(symbols);
+        names.reserve(symbols);
+    }
+
+    // Return the id for `symbol`, assigning the next free id if it is new
+    SymbolId intern(std::string_view symbol) {
+        if (symbol.empty() || symbol.length() > 8) {
+            throw std::invalid_argument("Symbol must be 1 to 8 chars");
+        }
+        if (auto it = ids.find(symbol); it != ids.end()) {
+            return it->second;
+        }
+        const SymbolId id = static_cast<SymbolId>(names.size());
+        ids.emplace(symbol, id);
+        names.emplace_back(symbol);
+        return id;
+    }
+
+    // Id of a known symbol, or invalidId
+    SymbolId find(std::string_view symbol) const {
+        auto it = ids.find(symbol);
+        return it == ids.end() ? invalidId : it->second;
+    }
+
+    const std::string& name(SymbolId id) const {
+        return names.at(id);
+    }
+
+    std::size_t size() const {
+        return names.size();
+    }
+};
+
+// How a BookUpdate changes its level
+enum class UpdateAction : uint8_t {
+    Add,    // Add volume to the level, creating it if needed
+    Set,    // Replace the level's volume (0 deletes it)
+    Delete  // Remove the level whatever its volume; volume is ignored
+};
+
+// One level update for the symbol with id `symbol`
+struct BookUpdate {
+    SymbolId symbol;
+    Side side;
+    double price;
+    int volume;
+    UpdateAction action = UpdateAction::Add;
+};
+
+// Holds one PriceCalculator book per symbol, indexed by SymbolId.
+//
+// Register every symbol during warm-up with the expected number of levels per
+// side; as long as a book stays within that depth, updates never allocate.
+class BookManager {
+private:
+    SymbolTable symbols;
+    std::vector<PriceCalculator> books;
+    std::size_t levelsPerSide;
+
+public:
+    explicit BookManager(std::size_t expectedSymbols = 1024, std::size_t levelsPerSide = 256)
+        : levelsPerSide(levelsPerSide) {
+        symbols.reserve(expectedSymbols);
+        books.reserve(expectedSymbols);
+    }
+
+    // Register a symbol (idempotent) and return its id
+    SymbolId addSymbol(std::string_view symbol) {
+        SymbolId id = symbols.intern(symbol);
+        if (id == books.size()) {
+            books.emplace_back(0);
+            books.back().reserveLevels(levelsPerSide);
+        }
+        return id;
+    }
+
+    SymbolId findSymbol(std::string_view symbol) const {
+        return symbols.find(symbol);
+    }
+
+    const std::string& symbolName(SymbolId id) const {
+        return symbols.name(id);
+    }
+
+    std::size_t symbolCount() const {
+        return books.size();
+    }
+
+    // Hot path: plain array indexing, no hashing
+    PriceCalculator& book(SymbolId id) {
+        return books[id];
+    }
+
+    const PriceCalculator& book(SymbolId id) const {
+        return books[id];
+    }
+
+    void applyUpdate(const BookUpdate& update) {
+        PriceCalculator& target = books[update.symbol];
+        if (update.action == UpdateAction::Add) {
+            if (update.side == Side::Bid) {
+                target.addBid(update.price, update.volume);
+            } else {
+                target.addAsk(update.price, update.volume);
+            }
+            return;
+        }
+        const int volume = update.action == UpdateAction::Delete ? 0 : update.volume;
+        if (update.side == Side::Bid) {
+            target.setBid(update.price, volume);
+        } else {
+            target.setAsk(update.price, volume);
+        }
+    }
+
+    // Apply a batch of updates in feed order
+    void applyUpdates(std::span<const BookUpdate> updates) {
+        for (const auto& update : updates) {
+            applyUpdate(update);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef BOOK_SIGNALS_H
+#define BOOK_SIGNALS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "book_delta.h"
+#include "price_calculator.h"
+#include "seqlock.h"
+
+// Top-of-book and near-touch signals derived from a PriceCalculator book
+struct BookSignals {
+    double bestBid = 0.0;
+    double bestAsk = 0.0;
+    double spread = 0.0;
+    double mid = 0.0;
+    double microprice = 0.0;        // Mid weighted towards the side with less size
+    double imbalance = 0.0;         // (bid depth - ask depth) / total depth, in [-1, 1]
+    double depthWeightedMid = 0.0;  // Microprice generalised to the top Depth levels
+    uint64_t updates = 0;           // Number of book changes seen
+};
+
+// Keeps BookSignals up to date from the book's delta stream and publishes
+// them through a seqlock, so strategy threads can read a consistent snapshot
+// without locking.
+//
+// The publisher caches the best `Depth` levels of each side with their
+// running price * volume and volume sums. Each delta adjusts the cache and
+// the sums for the one level it names, and only a delete inside the top
+// levels reads the book, to pull in the level that moves up. Attach it with
+// book.setDeltaListener(&publisher), and call rebuild() after changing the
+// book without deltas (e.g. loadSnapshot).
+template <std::size_t Depth = 5>
+class BookSignalPublisher : public BookDeltaListener {
+    static_assert(Depth > 0, "Depth must be at least one level");
+
+private:
+    // Best levels of one side, best first
+    struct TopLevels {
+        std::array<std::pair<double, int>, Depth> levels;
+        std::size_t count = 0;
+        double priceVolume = 0.0;
+        int64_t volume = 0;  // Exact, so imbalance never drifts
+    };
+
+    // The double sums are re-added from the cache this often, so the rounding
+    // left by adding and subtracting stays bounded
+    static constexpr uint64_t resumInterval = 1024;
+
+    const PriceCalculator& book;
+    SeqLock<BookSignals> published;
+    TopLevels bidTop;
+    TopLevels askTop;
+    uint64_t updates = 0;
+
+    // Bids improve upwards, asks downwards
+    static bool isBetter(Side side, double a, double b) {
+        return side == Side::Bid ? a > b : a < b;
+    }
+
+    static void addLevel(TopLevels& top, const std::pair<double, int>& level, int sign) {
+        top.priceVolume += sign * level.first * level.second;
+        top.volume += sign * level.second;
+    }
+
+    static void resum(TopLevels& top) {
+        top.priceVolume = 0.0;
+        for (std::size_t i = 0; i < top.count; i++) {
+            top.priceVolume += top.levels[i].first * top.levels[i].second;
+        }
+    }
+
+    static void fill(TopLevels& top, const std::vector<std::pair<double, int>>& levels) {
+        top = TopLevels{};
+        const std::size_t count = levels.size() < Depth ? levels.size() : Depth;
+        for (std::size_t i = 0; i < count; i++) {
+            top.levels[i] = levels[levels.size() - 1 - i];
+            addLevel(top, top.levels[i], 1);
+        }
+        top.count = count;
+    }
+
+    // Apply one delta to the cached top of its side
+    void apply(const BookDelta& delta) {
+        TopLevels& top = delta.side == Side::Bid ? bidTop : askTop;
+        std::size_t i = 0;
+        while (i < top.count && isBetter(delta.side, top.levels[i].first, delta.price)) {
+            i++;
+        }
+        const bool cached = i < top.count && top.levels[i].first == delta.price;
+
+        switch (delta.action) {
+            case DeltaAction::Change:
+                if (cached) {
+                    top.priceVolume += delta.price * (delta.volume - top.levels[i].second);
+                    top.volume += delta.volume - top.levels[i].second;
+                    top.levels[i].second = delta.volume;
+                }
+                break;
+            case DeltaAction::Add:
+                if (i == Depth) break;  // Below the top levels
+                if (top.count == Depth) {
+                    addLevel(top, top.levels[--top.count], -1);
+                }
+                for (std::size_t j = top.count; j > i; j--) {
+                    top.levels[j] = top.levels[j - 1];
+                }
+                top.levels[i] = std::make_pair(delta.price, static_cast<int>(delta.volume));
+                addLevel(top, top.levels[i], 1);
+                top.count++;
+                break;
+            case DeltaAction::Delete: {
+                if (!cached) break;
+                addLevel(top, top.levels[i], -1);
+                for (std::size_t j = i + 1; j < top.count; j++) {
+                    top.levels[j - 1] = top.levels[j];
+                }
+                top.count--;
+                // The next level down moves into the top, if the book has one
+                const auto& levels = delta.side == Side::Bid ? book.getBids() : book.getAsks();
+                if (levels.size() >= Depth) {
+                    top.levels[top.count] = levels[levels.size() - Depth];
+                    addLevel(top, top.levels[top.count], 1);
+                    top.count++;
+                }
+                break;
+            }
+        }
+    }
+
+    void publish() {
+        BookSignals signals;
+        signals.updates = ++updates;
+        if (updates % resumInterval == 0) {
+            resum(bidTop);
+            resum(askTop);
+        }
+
+        if (bidTop.count > 0 && askTop.count > 0) {
+            const auto& bid = bidTop.levels[0];
+            const auto& ask = askTop.levels[0];
+            signals.bestBid = bid.first;
+            signals.bestAsk = ask.first;
+            signals.spread = ask.first - bid.first;
+            signals.mid = 0.5 * (bid.first + ask.first);
+
+            const double topVolume = static_cast<double>(bid.second) + ask.second;
+            signals.microprice = (bid.first * ask.second + ask.first * bid.second) / topVolume;
+
+            const double bidVolume = static_cast<double>(bidTop.volume);
+            const double askVolume = static_cast<double>(askTop.volume);
+            const double depth = bidVolume + askVolume;
+            signals.imbalance = (bidVolume - askVolume) / depth;
+
+            const double bidVWAP = bidTop.priceVolume / bidVolume;
+            const double askVWAP = askTop.priceVolume / askVolume;
+            signals.depthWeightedMid = (bidVWAP * askVolume + askVWAP * bidVolume) / depth;
+        }
+
+        published.store(signals);
+    }
+
+public:
+    // Builds the cache from the current book and publishes the first snapshot
+    explicit BookSignalPublisher(const PriceCalculator& book) : book(book) {
+        rebuild();
+    }
+
+    // Writer thread: called by the book after every level change
+    void onDelta(const BookDelta& delta) override {
+        apply(delta);
+        publish();
+    }
+
+    // Writer thread: re-read the top levels after the book changed without deltas
+    void rebuild() {
+        fill(bidTop, book.getBids());
+        fill(askTop, book.getAsks());
+        publish();
+    }
+
+    // Any thread: latest consistent snapshot
+    BookSignals read() const {
+        return published.load();
+    }
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef BOOK_SNAPSHOT_H
+#define BOOK_SNAPSHOT_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "price_calculator.h"
+#include "seqlock.h"
+
+// A price level as stored in a snapshot
+struct SnapshotLevel {
+    double price;
+    int64_t volume;
+};
+
+// Best `Depth` levels of each side, best first
+template <std::size_t Depth>
+struct BookSnapshot {
+    uint64_t version = 0;
+    uint32_t bidCount = 0;
+    uint32_t askCount = 0;
+    std::array<SnapshotLevel, Depth> bids{};
+    std::array<SnapshotLevel, Depth> asks{};
+};
+
+// Publishes top-of-book snapshots from one writer thread to many readers.
+//
+// Snapshots go round-robin into `Slots` seqlocked slots and a version counter
+// points at the newest one. The writer never waits. A reader only has to retry
+// if the writer wraps around all slots while that reader is copying one, so
+// readers rarely retry even when the writer publishes continuously.
+template <std::size_t Depth = 10, std::size_t Slots = 8>
+class BookSnapshotPublisher {
+    static_assert(Slots >= 2, "At least two slots are needed to avoid reader retries");
+
+private:
+    std::array<SeqLock<BookSnapshot<Depth>>, Slots> slots;
+    alignas(64) std::atomic<uint64_t> latest{0};
+
+    static uint32_t copyTop(const std::vector<std::pair<double, int>>& levels,
+                            std::array<SnapshotLevel, Depth>& out) {
+        const std::size_t count = std::min(levels.size(), Depth);
+        const std::pair<double, int>* ptr = levels.data() + levels.size();
+        for (std::size_t i = 0; i < count; i++) {
+            ptr--;
+            out[i] = SnapshotLevel{ptr->first, ptr->second};
+        }
+        return static_cast<uint32_t>(count);
+    }
+
+public:
+    // Writer thread: copy the top of `book` and make it the latest snapshot
+    void publish(const PriceCalculator& book) {
+        BookSnapshot<Depth> snapshot;
+        snapshot.version = latest.load(std::memory_order_relaxed) + 1;
+        snapshot.bidCount = copyTop(book.getBids(), snapshot.bids);
+        snapshot.askCount = copyTop(book.getAsks(), snapshot.asks);
+        publish(snapshot);
+    }
+
+    // Writer thread: publish a snapshot built elsewhere; its version is overwritten
+    void publish(BookSnapshot<Depth> snapshot) {
+        const uint64_t version = latest.load(std::memory_order_relaxed) + 1;
+        snapshot.version = version;
+        slots[version % Slots].store(snapshot);
+        latest.store(version, std::memory_order_release);
+    }
+
+    // Any thread: newest consistent snapshot (version 0 if nothing published yet)
+    BookSnapshot<Depth> read() const {
+        BookSnapshot<Depth> snapshot;
+        for (;;) {
+            const uint64_t version = latest.load(std::memory_order_acquire);
+            if (slots[version % Slots].tryLoad(snapshot) && snapshot.version == version) {
+                return snapshot;
+            }
+        }
+    }
+
+    uint64_t version() const {
+        return latest.load(std::memory_order_acquire);
+    }
+};
+
+#endif
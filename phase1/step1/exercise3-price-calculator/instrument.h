@@ -0,0 +1,254 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "market_types.h"
+
+// A tick-size regime: from `fromPrice` upwards prices move in steps of `tickSize`
+struct TickBand {
+    double fromPrice;
+    double tickSize;
+};
+
+// Instrument classes, described entirely at compile time. Each one lists its
+// tick bands in increasing price order (the first band starts at minPrice),
+// the price bounds and the lot size.
+
+// US equity style: sub-dollar prices in 0.0001, otherwise in cents
+struct UsEquityClass {
+    static constexpr std::array<TickBand, 2> tickBands{{{0.0001, 0.0001}, {1.00, 0.01}}};
+    static constexpr double minPrice = 0.0001;
+    static constexpr double maxPrice = 1000.00;
+    static constexpr int64_t lotSize = 1;
+};
+
+// Equity index future: quarter-point ticks
+struct IndexFutureClass {
+    static constexpr std::array<TickBand, 1> tickBands{{{1000.0, 0.25}}};
+    static constexpr double minPrice = 1000.0;
+    static constexpr double maxPrice = 10000.0;
+    static constexpr int64_t lotSize = 1;
+};
+
+// FX spot: fractional pips, traded in thousands
+struct FxSpotClass {
+    static constexpr std::array<TickBand, 1> tickBands{{{0.5, 0.00001}}};
+    static constexpr double minPrice = 0.5;
+    static constexpr double maxPrice = 2.0;
+    static constexpr int64_t lotSize = 1000;
+};
+
+// Price <-> tick conversion and validation specialised for one instrument class.
+//
+// Ticks are dense indices 0 .. ladderSize - 1 across all bands. The band table
+// is generated with constexpr, and the band is picked by summing comparisons
+// against it, so conversion and validation compile to straight-line code.
+template <typename Spec>
+class Instrument {
+private:
+    static constexpr std::size_t bandCount = Spec::tickBands.size();
+
+    struct BandTable {
+        std::array<double, bandCount> fromPrice{};
+        std::array<double, bandCount> tickSize{};
+        std::array<double, bandCount> ticksPerUnit{};
+        std::array<int64_t, bandCount> firstTick{};
+        int64_t totalTicks = 0;
+    };
+
+    // Non-negative round-to-nearest usable in constant expressions
+    static constexpr int64_t roundTicks(double x) {
+        return static_cast<int64_t>(x + 0.5);
+    }
+
+    static constexpr BandTable makeTable() {
+        BandTable t;
+        int64_t tick = 0;
+        for (std::size_t i = 0; i < bandCount; i++) {
+            t.fromPrice[i] = Spec::tickBands[i].fromPrice;
+            t.tickSize[i] = Spec::tickBands[i].tickSize;
+            t.ticksPerUnit[i] = 1.0 / Spec::tickBands[i].tickSize;
+            t.firstTick[i] = tick;
+            const double bandEnd = (i + 1 < bandCount) ? Spec::tickBands[i + 1].fromPrice : Spec::maxPrice;
+            tick += roundTicks((bandEnd - t.fromPrice[i]) * t.ticksPerUnit[i]);
+        }
+        t.totalTicks = tick + 1;  // maxPrice itself is a valid tick
+        return t;
+    }
+
+    static constexpr BandTable table = makeTable();
+
+    static constexpr bool bandsAreValid() {
+        if (Spec::tickBands[0].fromPrice != Spec::minPrice) return false;
+        for (std::size_t i = 0; i < bandCount; i++) {
+            if (Spec::tickBands[i].tickSize <= 0.0) return false;
+            if (i > 0 && Spec::tickBands[i].fromPrice <= Spec::tickBands[i - 1].fromPrice) return false;
+        }
+        return Spec::maxPrice > Spec::minPrice && Spec::lotSize > 0;
+    }
+
+    static_assert(bandCount > 0, "An instrument needs at least one tick band");
+    static_assert(bandsAreValid(), "Tick bands must start at minPrice and increase");
+
+    // Branch-free band lookup: count the band starts at or below the value
+    static constexpr std::size_t bandForPrice(double price) {
+        std::size_t band = 0;
+        for (std::size_t i = 1; i < bandCount; i++) {
+            band += static_cast<std::size_t>(price >= table.fromPrice[i]);
+        }
+        return band;
+    }
+
+    static constexpr std::size_t bandForTicks(int64_t ticks) {
+        std::size_t band = 0;
+        for (std::size_t i = 1; i < bandCount; i++) {
+            band += static_cast<std::size_t>(ticks >= table.firstTick[i]);
+        }
+        return band;
+    }
+
+public:
+    using SpecType = Spec;
+
+    // Number of distinct prices: size of a directly indexed price ladder
+    static constexpr int64_t ladderSize = table.totalTicks;
+    static constexpr double minPrice = Spec::minPrice;
+    static constexpr double maxPrice = Spec::maxPrice;
+    static constexpr int64_t lotSize = Spec::lotSize;
+
+    // Nearest tick to `price`. Only call it once isValidPrice(price) holds: the
+    // float-to-int conversion is undefined for huge, infinite or NaN prices.
+    static constexpr int64_t toTicks(double price) {
+        const std::size_t band = bandForPrice(price);
+        return table.firstTick[band] +
+               roundTicks((price - table.fromPrice[band]) * table.ticksPerUnit[band]);
+    }
+
+    static constexpr double toPrice(int64_t ticks) {
+        const std::size_t band = bandForTicks(ticks);
+        return table.fromPrice[band] + static_cast<double>(ticks - table.firstTick[band]) * table.tickSize[band];
+    }
+
+    // One unsigned compare covers both bounds
+    static constexpr bool isValidTicks(int64_t ticks) {
+        return static_cast<uint64_t>(ticks) < static_cast<uint64_t>(ladderSize);
+    }
+
+    static constexpr bool isValidPrice(double price) {
+        return (price >= minPrice) & (price <= maxPrice);
+    }
+
+    // lotSize is a compile-time constant, so the modulo becomes a multiply or mask
+    static constexpr bool isValidQuantity(int64_t quantity) {
+        return (quantity > 0) & (quantity % lotSize == 0);
+    }
+
+    // True if `price` is in range and lies exactly on the tick grid (within rounding noise)
+    static constexpr bool isOnTick(double price) {
+        if (!isValidPrice(price)) return false;
+        const double snapped = toPrice(toTicks(price));
+        const double diff = snapped > price ? snapped - price : price - snapped;
+        return diff < 1e-9 * (price > 1.0 ? price : 1.0);
+    }
+};
+
+// Compile-time checks on the shipped instrument classes
+static_assert(Instrument<UsEquityClass>::toTicks(1.00) == 9999);
+static_assert(Instrument<UsEquityClass>::ladderSize == 9999 + 99900 + 1);
+static_assert(Instrument<UsEquityClass>::isOnTick(123.45));  // Two-sided round-trip check
+static_assert(!Instrument<UsEquityClass>::isOnTick(123.455));
+static_assert(!Instrument<UsEquityClass>::isOnTick(1e300));  // Rejected before any conversion
+static_assert(Instrument<IndexFutureClass>::ladderSize == 36001);
+static_assert(Instrument<FxSpotClass>::isValidQuantity(5000));
+static_assert(!Instrument<FxSpotClass>::isValidQuantity(1500));
+
+// Aggregated book indexed directly by tick: the ladder is sized at compile
+// time from the instrument class, and updates are array increments.
+template <typename Spec>
+class TickLadder {
+private:
+    using Traits = Instrument<Spec>;
+
+    std::vector<int64_t> bidVolume;
+    std::vector<int64_t> askVolume;
+    int64_t bestBid = -1;                  // -1 when there are no bids
+    int64_t bestAsk = Traits::ladderSize;  // ladderSize when there are no asks
+
+public:
+    TickLadder() : bidVolume(Traits::ladderSize, 0), askVolume(Traits::ladderSize, 0) {}
+
+    // Hot path: caller has validated `ticks` (e.g. with Instrument::isValidTicks)
+    void addBid(int64_t ticks, int64_t quantity) {
+        bidVolume[ticks] += quantity;
+        bestBid = std::max(bestBid, ticks);
+    }
+
+    void addAsk(int64_t ticks, int64_t quantity) {
+        askVolume[ticks] += quantity;
+        bestAsk = std::min(bestAsk, ticks);
+    }
+
+    // Validating entry point for untrusted prices; returns false if rejected
+    bool add(Side side, double price, int64_t quantity) {
+        if (!(Traits::isOnTick(price) & Traits::isValidQuantity(quantity))) {
+            return false;
+        }
+        const int64_t ticks = Traits::toTicks(price);
+        if (side == Side::Bid) {
+            addBid(ticks, quantity);
+        } else {
+            addAsk(ticks, quantity);
+        }
+        return true;
+    }
+
+    // Take volume off a level; the best price is rescanned only if that level empties
+    void removeBid(int64_t ticks, int64_t quantity) {
+        bidVolume[ticks] = std::max<int64_t>(0, bidVolume[ticks] - quantity);
+        while (bestBid >= 0 && bidVolume[bestBid] == 0) bestBid--;
+    }
+
+    void removeAsk(int64_t ticks, int64_t quantity) {
+        askVolume[ticks] = std::max<int64_t>(0, askVolume[ticks] - quantity);
+        while (bestAsk < Traits::ladderSize && askVolume[bestAsk] == 0) bestAsk++;
+    }
+
+    bool hasBid() const {
+        return bestBid >= 0;
+    }
+
+    bool hasAsk() const {
+        return bestAsk < Traits::ladderSize;
+    }
+
+    int64_t bestBidTicks() const {
+        return bestBid;
+    }
+
+    int64_t bestAskTicks() const {
+        return bestAsk;
+    }
+
+    double bestBidPrice() const {
+        return hasBid() ? Traits::toPrice(bestBid) : 0.0;
+    }
+
+    double bestAskPrice() const {
+        return hasAsk() ? Traits::toPrice(bestAsk) : 0.0;
+    }
+
+    int64_t bidVolumeAt(int64_t ticks) const {
+        return bidVolume[ticks];
+    }
+
+    int64_t askVolumeAt(int64_t ticks) const {
+        return askVolume[ticks];
+    }
+};
+
+#endif
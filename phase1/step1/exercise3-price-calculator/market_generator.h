@@ -0,0 +1,219 @@
+#ifndef MARKET_GENERATOR_H
+#define MARKET_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "market_types.h"
+
+// xoshiro256** by Blackman and Vigna: small state, a few ns per number,
+// and identical output on every platform for the same seed.
+// Satisfies UniformRandomBitGenerator, so it also works with <random>.
+class Xoshiro256 {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // splitmix64 expands one seed into a well-mixed initial state
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed) {
+        for (auto& s : state) {
+            s = splitmix64(seed);
+        }
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, bound) using Lemire's multiply-shift (no division)
+    uint64_t nextBelow(uint64_t bound) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>((*this)()) * bound) >> 64);
+    }
+
+    // Uniform double in [0, 1)
+    double nextDouble() {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+};
+
+// Parameters for a synthetic market
+struct MarketConfig {
+    uint64_t seed = 42;
+    double midPrice = 101.0;
+    double tickSize = 0.01;
+    int minVolume = 100;
+    int maxVolume = 999;
+    int64_t meanTradeGapNanos = 1'000'000;  // Average time between trades
+};
+
+// Generates books and tick streams in bulk, reproducibly from a seed.
+// Each instance owns its generator, so separate instances can run on separate threads.
+// Every generated price is positive: book depths that would reach zero are
+// rejected, and the trade walk reflects off its lowest positive tick.
+class MarketGenerator {
+private:
+    MarketConfig config;
+    Xoshiro256 rng;
+
+    int nextVolume() {
+        const uint64_t range = static_cast<uint64_t>(config.maxVolume - config.minVolume + 1);
+        return config.minVolume + static_cast<int>(rng.nextBelow(range));
+    }
+
+public:
+    explicit MarketGenerator(const MarketConfig& config = MarketConfig())
+        : config(config), rng(config.seed) {
+        if (!(config.midPrice > 0.0) || !(config.tickSize > 0.0)) {
+            throw std::invalid_argument("Mid price and tick size must be positive");
+        }
+        if (config.minVolume <= 0 || config.minVolume > config.maxVolume) {
+            throw std::invalid_argument("Volume range must be positive and non-empty");
+        }
+    }
+
+    const MarketConfig& getConfig() const {
+        return config;
+    }
+
+    Xoshiro256& generator() {
+        return rng;
+    }
+
+    // Deepest bid book (or order offset in ticks) whose prices all stay positive
+    std::size_t maxBidDepth() const {
+        std::size_t depth = static_cast<std::size_t>(config.midPrice / config.tickSize);
+        while (depth > 0 && config.midPrice - depth * config.tickSize <= 0.0) {
+            depth--;
+        }
+        return depth;
+    }
+
+    // Append `depth` bid levels one tick apart, ordered worst to best.
+    // The best bid is one tick below the mid price; throws if the worst would
+    // not be positive (see maxBidDepth).
+    void generateBids(std::size_t depth, std::vector<std::pair<double, int>>& out) {
+        if (depth > maxBidDepth()) {
+            throw std::invalid_argument("Bid depth reaches a non-positive price");
+        }
+        out.reserve(out.size() + depth);
+        for (std::size_t i = depth; i > 0; i--) {
+            out.push_back(std::make_pair(config.midPrice - i * config.tickSize, nextVolume()));
+        }
+    }
+
+    // Append `depth` ask levels one tick apart, ordered worst to best.
+    // The best ask is one tick above the mid price.
+    void generateAsks(std::size_t depth, std::vector<std::pair<double, int>>& out) {
+        out.reserve(out.size() + depth);
+        for (std::size_t i = depth; i > 0; i--) {
+            out.push_back(std::make_pair(config.midPrice + i * config.tickSize, nextVolume()));
+        }
+    }
+
+    // Append `count` trades following a one-tick random walk around the mid price.
+    // A step below the lowest positive tick is reflected back up.
+    // Gaps between trades are uniform in [0, 2 * meanTradeGapNanos].
+    void generateTrades(std::size_t count, int64_t startTimestamp, std::vector<Trade>& out) {
+        out.reserve(out.size() + count);
+        int64_t timestamp = startTimestamp;
+        int64_t ticks = 0;
+        const int64_t lowestTicks = -static_cast<int64_t>(maxBidDepth());
+        const uint64_t gapRange = static_cast<uint64_t>(2 * config.meanTradeGapNanos + 1);
+        for (std::size_t i = 0; i < count; i++) {
+            ticks += static_cast<int64_t>(rng.nextBelow(3)) - 1;
+            if (ticks < lowestTicks) {
+                ticks = lowestTicks + 1;
+            }
+            timestamp += static_cast<int64_t>(rng.nextBelow(gapRange));
+            out.push_back(Trade{timestamp, config.midPrice + ticks * config.tickSize, nextVolume()});
+        }
+    }
+
+    // Append `count` valid L3 messages: about 45% adds, 35% cancels, 12% modifies
+    // and 8% executions. Cancels, modifies and executions always refer to a live
+    // order. Orders rest 1 to `priceLevels` ticks away from the mid price, which
+    // must keep bids positive.
+    void generateOrderFlow(std::size_t count, std::vector<OrderMessage>& out, int priceLevels = 50) {
+        if (priceLevels <= 0 || static_cast<std::size_t>(priceLevels) > maxBidDepth()) {
+            throw std::invalid_argument("Order price levels reach a non-positive price");
+        }
+        struct LiveOrder {
+            uint64_t id;
+            Side side;
+            double price;
+            int quantity;
+        };
+        std::vector<LiveOrder> live;
+        uint64_t nextId = 1;
+        out.reserve(out.size() + count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            const uint64_t roll = rng.nextBelow(100);
+            if (live.empty() || roll < 45) {
+                const Side side = rng.nextBelow(2) == 0 ? Side::Bid : Side::Ask;
+                const double offset = static_cast<double>(1 + rng.nextBelow(priceLevels)) * config.tickSize;
+                const double price = side == Side::Bid ? config.midPrice - offset : config.midPrice + offset;
+                const int quantity = nextVolume();
+                out.push_back(OrderMessage{OrderMessageType::Add, side, nextId, price, quantity});
+                live.push_back(LiveOrder{nextId, side, price, quantity});
+                nextId++;
+                continue;
+            }
+
+            const std::size_t index = rng.nextBelow(live.size());
+            LiveOrder& order = live[index];
+            if (roll < 80) {
+                out.push_back(OrderMessage{OrderMessageType::Cancel, order.side, order.id, order.price, 0});
+                order = live.back();
+                live.pop_back();
+            } else if (roll < 92) {
+                order.quantity = nextVolume();
+                out.push_back(OrderMessage{OrderMessageType::Modify, order.side, order.id, order.price,
+                                           order.quantity});
+            } else {
+                const int filled = 1 + static_cast<int>(rng.nextBelow(order.quantity));
+                out.push_back(OrderMessage{OrderMessageType::Execute, order.side, order.id, order.price, filled});
+                order.quantity -= filled;
+                if (order.quantity == 0) {
+                    order = live.back();
+                    live.pop_back();
+                }
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef MARKET_TYPES_H
+#define MARKET_TYPES_H
+
+#include <cstdint>
+
+// Small integer handle for an interned symbol
+using SymbolId = uint32_t;
+
+// Which side of the book to read
+enum class Side {
+    Bid,
+    Ask
+};
+
+// A single timestamped trade (timestamp in nanoseconds)
+struct Trade {
+    int64_t timestamp;
+    double price;
+    int volume;
+};
+
+// Order-by-order (L3) feed message types
+enum class OrderMessageType : uint8_t {
+    Add,
+    Cancel,
+    Modify,   // New quantity at the same price
+    Execute   // Fill against a resting order
+};
+
+// One L3 feed message. Cancel ignores side/price/quantity; Execute uses
+// quantity as the filled amount.
+struct OrderMessage {
+    OrderMessageType type;
+    Side side;
+    uint64_t orderId;
+    double price;
+    int quantity;
+};
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "book_arena.h"
+#include "market_types.h"
+#include "order_id_index.h"
+
+// Link value meaning "no order" / "no level"
+constexpr uint32_t nullSlot = UINT32_MAX;
+
+// Fields touched on every add/cancel/modify/execute. 16 bytes, so four orders
+// share a cache line and none straddles two.
+struct alignas(16) OrderHot {
+    int32_t quantity;
+    uint32_t level;
+    uint32_t prev;  // Older order at the same level (free list link when unused)
+    uint32_t next;  // Newer order at the same level
+};
+
+// Fields only needed for reporting, kept out of the hot array
+struct OrderCold {
+    uint64_t id;
+    Side side;
+};
+
+// One price level. 32 bytes: two per cache line.
+struct alignas(32) LevelHot {
+    double price;
+    int64_t totalQuantity;
+    uint32_t orderCount;
+    uint32_t head;  // Oldest order (free list link when unused)
+    uint32_t tail;  // Newest order
+};
+
+// Read-only copies handed out by queries
+struct LevelView {
+    double price;
+    int64_t totalQuantity;
+    uint32_t orderCount;
+    uint64_t headOrderId;
+};
+
+struct OrderView {
+    uint64_t id;
+    Side side;
+    double price;
+    int quantity;
+};
+
+// Order-by-order (L3) book.
+//
+// Each price level keeps an intrusive doubly linked FIFO of its orders, and an
+// order-id hash index points straight at the order, so cancel, modify and
+// execute are O(1). A level emptied by them is erased from its price map
+// through the iterator stored when it was opened (amortized O(1)), with no
+// key lookup. Adding an order is O(1) at an existing price; opening a new
+// price level costs O(log levels) to keep the sides sorted.
+//
+// Nothing is heap-allocated per order or per level: orders and levels live in
+// chunked slabs addressed by 32-bit slots and recycled through free lists,
+// the id index is open addressing, and the sorted price maps take their nodes
+// from a per-book arena. Once the reserved capacity is reached, growth happens
+// a whole chunk at a time.
+class OrderBook {
+private:
+    using PriceMapAllocator = ArenaAllocator<std::pair<const double, uint32_t>>;
+    using BidMap = std::map<double, uint32_t, std::greater<double>, PriceMapAllocator>;
+    using AskMap = std::map<double, uint32_t, std::less<double>, PriceMapAllocator>;
+
+    // Where a level sits in its side's price map. The field for the other side
+    // (and both, once the level is freed) holds end(), so every stored
+    // iterator stays copyable. Only read when the level is dropped, so kept
+    // out of LevelHot, and in a vector because map iterators need not be
+    // trivially copyable.
+    struct LevelCold {
+        BidMap::iterator bid;
+        AskMap::iterator ask;
+    };
+
+    ChunkedArray<OrderHot> orderHot;
+    ChunkedArray<OrderCold> orderCold;
+    ChunkedArray<LevelHot> levels;
+    std::vector<LevelCold> levelCold;  // Indexed by level slot
+    uint32_t orderHighWater = 0;
+    uint32_t levelHighWater = 0;
+    uint32_t freeOrders = nullSlot;
+    uint32_t freeLevels = nullSlot;
+    std::size_t liveOrders = 0;
+
+    OrderIdIndex index;
+    FixedBlockArena mapArena;  // Declared before the maps that allocate from it
+    BidMap bids;               // Best (highest) first, price -> level slot
+    AskMap asks;               // Best (lowest) first
+
+    uint32_t allocateOrder() {
+        if (freeOrders != nullSlot) {
+            const uint32_t slot = freeOrders;
+            freeOrders = orderHot[slot].prev;
+            return slot;
+        }
+        orderHot.ensure(orderHighWater + 1);
+        orderCold.ensure(orderHighWater + 1);
+        return orderHighWater++;
+    }
+
+    void freeOrder(uint32_t slot) {
+        orderHot[slot].prev = freeOrders;
+        freeOrders = slot;
+    }
+
+    uint32_t allocateLevel(double price) {
+        uint32_t slot;
+        if (freeLevels != nullSlot) {
+            slot = freeLevels;
+            freeLevels = levels[slot].head;
+        } else {
+            levels.ensure(levelHighWater + 1);
+            slot = levelHighWater++;
+            levelCold.push_back(LevelCold{bids.end(), asks.end()});
+        }
+        levels[slot] = LevelHot{price, 0, 0, nullSlot, nullSlot};
+        return slot;
+    }
+
+    template <typename Levels>
+    uint32_t levelAt(Levels& sideLevels, typename Levels::iterator LevelCold::*position, double price) {
+        auto it = sideLevels.lower_bound(price);
+        if (it != sideLevels.end() && it->first == price) return it->second;
+        const uint32_t slot = allocateLevel(price);
+        levelCold[slot].*position = sideLevels.emplace_hint(it, price, slot);
+        return slot;
+    }
+
+    void pushBack(uint32_t levelSlot, uint32_t slot) {
+        LevelHot& level = levels[levelSlot];
+        OrderHot& order = orderHot[slot];
+        order.level = levelSlot;
+        order.prev = level.tail;
+        order.next = nullSlot;
+        if (level.tail != nullSlot) {
+            orderHot[level.tail].next = slot;
+        } else {
+            level.head = slot;
+        }
+        level.tail = slot;
+        level.totalQuantity += order.quantity;
+        level.orderCount++;
+    }
+
+    void unlink(uint32_t slot) {
+        OrderHot& order = orderHot[slot];
+        LevelHot& level = levels[order.level];
+        if (order.prev != nullSlot) {
+            orderHot[order.prev].next = order.next;
+        } else {
+            level.head = order.next;
+        }
+        if (order.next != nullSlot) {
+            orderHot[order.next].prev = order.prev;
+        } else {
+            level.tail = order.prev;
+        }
+        level.totalQuantity -= order.quantity;
+        level.orderCount--;
+    }
+
+    // Remove an order completely and drop its level if that was the last order
+    void removeOrder(uint64_t id, uint32_t slot) {
+        unlink(slot);
+        const uint32_t levelSlot = orderHot[slot].level;
+        LevelHot& level = levels[levelSlot];
+        if (level.orderCount == 0) {
+            if (orderCold[slot].side == Side::Bid) {
+                bids.erase(levelCold[levelSlot].bid);
+            } else {
+                asks.erase(levelCold[levelSlot].ask);
+            }
+            levelCold[levelSlot] = LevelCold{bids.end(), asks.end()};
+            level.head = freeLevels;
+            freeLevels = levelSlot;
+        }
+        index.erase(id);
+        freeOrder(slot);
+        liveOrders--;
+    }
+
+    LevelView view(uint32_t levelSlot) const {
+        const LevelHot& level = levels[levelSlot];
+        return LevelView{level.price, level.totalQuantity, level.orderCount,
+                         level.head == nullSlot ? 0 : orderCold[level.head].id};
+    }
+
+public:
+    explicit OrderBook(std::size_t expectedOrders = 1 << 16, std::size_t expectedLevels = 1024)
+        : index(expectedOrders),
+          bids(PriceMapAllocator(&mapArena)),
+          asks(PriceMapAllocator(&mapArena)) {
+        orderHot.ensure(static_cast<uint32_t>(expectedOrders));
+        orderCold.ensure(static_cast<uint32_t>(expectedOrders));
+        levels.ensure(static_cast<uint32_t>(expectedLevels));
+        levelCold.reserve(expectedLevels);
+        mapArena.reserve(expectedLevels);
+    }
+
+    // Returns false if the id is already live or the quantity is not positive
+    bool addOrder(uint64_t id, Side side, double price, int quantity) {
+        if (quantity <= 0 || index.find(id) != OrderIdIndex::emptySlot) return false;
+        const uint32_t slot = allocateOrder();
+        index.insert(id, slot);
+        orderHot[slot].quantity = quantity;
+        orderCold[slot] = OrderCold{id, side};
+        const uint32_t levelSlot = side == Side::Bid ? levelAt(bids, &LevelCold::bid, price)
+                                                     : levelAt(asks, &LevelCold::ask, price);
+        pushBack(levelSlot, slot);
+        liveOrders++;
+        return true;
+    }
+
+    bool cancelOrder(uint64_t id) {
+        const uint32_t slot = index.find(id);
+        if (slot == OrderIdIndex::emptySlot) return false;
+        removeOrder(id, slot);
+        return true;
+    }
+
+    // Change quantity at the same price. A reduction keeps queue priority; an
+    // increase moves the order to the back of its level, as most venues do.
+    bool modifyOrder(uint64_t id, int newQuantity) {
+        const uint32_t slot = index.find(id);
+        if (slot == OrderIdIndex::emptySlot) return false;
+        if (newQuantity <= 0) {
+            removeOrder(id, slot);
+            return true;
+        }
+        OrderHot& order = orderHot[slot];
+        if (newQuantity <= order.quantity) {
+            levels[order.level].totalQuantity -= order.quantity - newQuantity;
+            order.quantity = newQuantity;
+        } else {
+            const uint32_t levelSlot = order.level;
+            unlink(slot);
+            order.quantity = newQuantity;
+            pushBack(levelSlot, slot);
+        }
+        return true;
+    }
+
+    // Change price and quantity: the order loses priority and rejoins at the new price
+    bool replaceOrder(uint64_t id, double newPrice, int newQuantity) {
+        const uint32_t slot = index.find(id);
+        if (slot == OrderIdIndex::emptySlot || newQuantity <= 0) return false;
+        const Side side = orderCold[slot].side;
+        removeOrder(id, slot);
+        return addOrder(id, side, newPrice, newQuantity);
+    }
+
+    // Fill `quantity` of a resting order; it is removed once fully filled.
+    // Returns the quantity actually executed.
+    int executeOrder(uint64_t id, int quantity) {
+        const uint32_t slot = index.find(id);
+        if (slot == OrderIdIndex::emptySlot || quantity <= 0) return 0;
+        OrderHot& order = orderHot[slot];
+        if (quantity >= order.quantity) {
+            const int filled = order.quantity;
+            removeOrder(id, slot);
+            return filled;
+        }
+        order.quantity -= quantity;
+        levels[order.level].totalQuantity -= quantity;
+        return quantity;
+    }
+
+    // Apply one feed message; returns false if it referred to an unknown order
+    bool apply(const OrderMessage& message) {
+        switch (message.type) {
+            case OrderMessageType::Add:
+                return addOrder(message.orderId, message.side, message.price, message.quantity);
+            case OrderMessageType::Cancel:
+                return cancelOrder(message.orderId);
+            case OrderMessageType::Modify:
+                return modifyOrder(message.orderId, message.quantity);
+            case OrderMessageType::Execute:
+                return executeOrder(message.orderId, message.quantity) > 0;
+        }
+        return false;
+    }
+
+    std::optional<OrderView> findOrder(uint64_t id) const {
+        const uint32_t slot = index.find(id);
+        if (slot == OrderIdIndex::emptySlot) return std::nullopt;
+        const OrderHot& order = orderHot[slot];
+        return OrderView{id, orderCold[slot].side, levels[order.level].price, order.quantity};
+    }
+
+    std::size_t orderCount() const {
+        return liveOrders;
+    }
+
+    std::size_t levelCount(Side side) const {
+        return side == Side::Bid ? bids.size() : asks.size();
+    }
+
+    // Best level on a side, if any
+    std::optional<LevelView> bestLevel(Side side) const {
+        if (side == Side::Bid) {
+            if (bids.empty()) return std::nullopt;
+            return view(bids.begin()->second);
+        }
+        if (asks.empty()) return std::nullopt;
+        return view(asks.begin()->second);
+    }
+
+    // L2 view in PriceCalculator's layout (worst to best), e.g. for calculateVWAP
+    std::vector<std::pair<double, int>> aggregatedLevels(Side side) const {
+        std::vector<std::pair<double, int>> result;
+        auto collect = [&](const auto& sideLevels) {
+            result.reserve(sideLevels.size());
+            for (auto it = sideLevels.rbegin(); it != sideLevels.rend(); ++it) {
+                result.push_back(std::make_pair(it->first, static_cast<int>(levels[it->second].totalQuantity)));
+            }
+        };
+        if (side == Side::Bid) {
+            collect(bids);
+        } else {
+            collect(asks);
+        }
+        return result;
+    }
+
+    // Chunks requested from the system so far (orders, levels and map nodes)
+    std::size_t chunkAllocations() const {
+        return orderHot.chunkCount() + orderCold.chunkCount() + levels.chunkCount() +
+               mapArena.chunkCount();
+    }
+};
+
+static_assert(sizeof(OrderHot) == 16, "Four hot order records per cache line");
+static_assert(sizeof(LevelHot) == 32, "Two level records per cache line");
+
+#endif
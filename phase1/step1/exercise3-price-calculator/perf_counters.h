@@ -0,0 +1,95 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters for the calling thread (and threads it starts while
+// counting), read through Linux perf_event_open. Where perf events are not
+// permitted (containers, perf_event_paranoid, non-Linux) every counter simply
+// reports as unavailable and timing-only benchmarks still work.
+class PerfCounters {
+public:
+    enum Counter { Cycles, Instructions, CacheMisses, BranchMisses, CounterCount };
+
+private:
+    std::array<int, CounterCount> fds;
+    std::array<uint64_t, CounterCount> values{};
+
+#ifdef __linux__
+    static int open(uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+        fds.fill(-1);
+#ifdef __linux__
+        fds[Cycles] = open(PERF_COUNT_HW_CPU_CYCLES);
+        fds[Instructions] = open(PERF_COUNT_HW_INSTRUCTIONS);
+        fds[CacheMisses] = open(PERF_COUNT_HW_CACHE_MISSES);
+        fds[BranchMisses] = open(PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(Counter counter) const {
+        return fds[counter] >= 0;
+    }
+
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int i = 0; i < CounterCount; i++) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t count = 0;
+            values[i] = (read(fds[i], &count, sizeof(count)) == sizeof(count)) ? count : 0;
+        }
+#endif
+    }
+
+    // Count from the last start/stop pair
+    uint64_t value(Counter counter) const {
+        return values[counter];
+    }
+};
+
+#endif
@@ -2,194 +2,16 @@
 #include <vector>
 #include <cmath>
 #include <iomanip>
-#include <cstdlib>
-#include <ctime>
 
-class PriceCalculator {
-private:
-    // A vector for bids and asks
-    std::vector<std::pair<double, int>> bids;
-    std::vector<std::pair<double, int>> asks;
-
-public:
-    PriceCalculator() {
-        // Seed the random number generator
-        std::srand(std::time(nullptr));
-        
-        // Initialize with some default prices
-        generateInitialPrices();
-    }
-
-    // Generate initial bid and ask prices
-    void generateInitialPrices() {
-        for (int i = 0; i < 100; i++) {
-            double bidPrice = 100.0 + i * 0.01;
-            int volume = rand() % 900 + 100;
-            bids.push_back(std::make_pair(bidPrice, volume));
-        }
-        for (int i = 0; i < 100; i++) {
-            double askPrice = 102.0 - i * 0.01;
-            int volume = rand() % 900 + 100;
-            asks.push_back(std::make_pair(askPrice, volume));
-        }
-    }
-
-    // Add a bid
-    void addBid(double price, int volume) {
-        bids.push_back(std::make_pair(price, volume));
-    }
-
-    // Add an ask
-    void addAsk(double price, int volume) {
-        asks.push_back(std::make_pair(price, volume));
-    }
-
-    // Calculate Volume Weighted Average Price for the vector of bids
-    double calculateVWAP(const std::vector<std::pair<double, int>>& bids) {
-        double totalVolume = 0;
-        double totalPriceVolume = 0;
-        for (const auto& bid : bids) {
-            totalVolume += bid.second;
-            totalPriceVolume += bid.first * bid.second;
-        }
-        return totalPriceVolume / totalVolume;
-    }
-
-    // Calculate VWAP using pointer arithmetic
-    double calculateVWAPWithPointers(const std::vector<std::pair<double, int>>& bids) {
-        if (bids.empty()) return 0.0;
-        
-        double totalVolume = 0;
-        double totalPriceVolume = 0;
-        
-        const std::pair<double, int>* ptr = bids.data();
-        const std::pair<double, int>* endPtr = bids.data() + bids.size();
-        
-        while (ptr < endPtr) {
-            totalVolume += ptr->second;
-            totalPriceVolume += ptr->first * ptr->second;
-            ptr++;
-        }
-        
-        return totalPriceVolume / totalVolume;
-    }
-
-    // Demonstrate pointer arithmetic with raw arrays
-    void demonstratePointerArithmetic() {
-        std::cout << "\n=== POINTER ARITHMETIC DEMONSTRATIONS ===\n";
-        
-        // Create a simple array for demonstration
-        double prices[] = {100.50, 101.25, 102.00, 103.75, 104.50};
-        int volumes[] = {1000, 1500, 2000, 1750, 1200};
-        const int size = 5;
-        
-        std::cout << "Original arrays:\n";
-        std::cout << "Prices: ";
-        for (int i = 0; i < size; i++) {
-            std::cout << prices[i] << " ";
-        }
-        std::cout << "\nVolumes: ";
-        for (int i = 0; i < size; i++) {
-            std::cout << volumes[i] << " ";
-        }
-        std::cout << "\n\n";
-        
-        // Method 1: Basic pointer arithmetic traversal
-        std::cout << "1. Basic pointer arithmetic traversal:\n";
-        double* pricePtr = prices;
-        int* volumePtr = volumes;
-        
-        for (int i = 0; i < size; i++) {
-            std::cout << "Price[" << i << "] = " << *(pricePtr + i) 
-                      << ", Volume[" << i << "] = " << *(volumePtr + i) << "\n";
-        }
-        
-        // Method 2: Pointer increment traversal
-        std::cout << "\n2. Pointer increment traversal:\n";
-        pricePtr = prices;
-        volumePtr = volumes;
-        
-        for (int i = 0; i < size; i++) {
-            std::cout << "Price[" << i << "] = " << *pricePtr 
-                      << ", Volume[" << i << "] = " << *volumePtr << "\n";
-            pricePtr++;  // Move to next element
-            volumePtr++; // Move to next element
-        }
-        
-        // Method 3: Pointer arithmetic for reverse traversal
-        std::cout << "\n3. Reverse traversal using pointer arithmetic:\n";
-        pricePtr = prices + size - 1;  // Point to last element
-        volumePtr = volumes + size - 1;
-        
-        for (int i = size - 1; i >= 0; i--) {
-            std::cout << "Price[" << i << "] = " << *pricePtr 
-                      << ", Volume[" << i << "] = " << *volumePtr << "\n";
-            pricePtr--;  // Move to previous element
-            volumePtr--;
-        }
-        
-        // Method 4: Pointer arithmetic for finding array bounds
-        std::cout << "\n4. Array bounds using pointer arithmetic:\n";
-        double* beginPtr = prices;
-        double* endPtr = prices + size;
-        
-        std::cout << "Array starts at: " << beginPtr << "\n";
-        std::cout << "Array ends at: " << endPtr << "\n";
-        std::cout << "Number of elements: " << (endPtr - beginPtr) << "\n";
-        
-        // Method 5: Pointer arithmetic for array manipulation
-        std::cout << "\n5. Array manipulation using pointers:\n";
-        pricePtr = prices;
-        volumePtr = volumes;
-        
-        // Double all prices and volumes
-        for (int i = 0; i < size; i++) {
-            *pricePtr *= 2.0;
-            *volumePtr *= 2;
-            pricePtr++;
-            volumePtr++;
-        }
-        
-        // Display modified arrays
-        std::cout << "Modified arrays (doubled):\n";
-        std::cout << "Prices: ";
-        for (int i = 0; i < size; i++) {
-            std::cout << prices[i] << " ";
-        }
-        std::cout << "\nVolumes: ";
-        for (int i = 0; i < size; i++) {
-            std::cout << volumes[i] << " ";
-        }
-        std::cout << "\n";
-        
-        // Method 6: Pointer arithmetic for finding specific elements
-        std::cout << "\n6. Finding elements using pointer arithmetic:\n";
-        pricePtr = prices;
-        volumePtr = volumes;
-        
-        // Find the maximum price
-        double* maxPricePtr = pricePtr;
-        for (int i = 1; i < size; i++) {
-            if (*(pricePtr + i) > *maxPricePtr) {
-                maxPricePtr = pricePtr + i;
-            }
-        }
-        
-        int maxIndex = maxPricePtr - pricePtr;  // Calculate index using pointer arithmetic
-        std::cout << "Maximum price: " << *maxPricePtr << " at index " << maxIndex << "\n";
-        
-        // Method 7: Pointer arithmetic for array slicing
-        std::cout << "\n7. Array slicing using pointer arithmetic:\n";
-        double* sliceStart = prices + 1;  // Start from second element
-        double* sliceEnd = prices + 4;    // End at fourth element
-        
-        std::cout << "Slice from index 1 to 3: ";
-        for (double* ptr = sliceStart; ptr <= sliceEnd; ptr++) {
-            std::cout << *ptr << " ";
-        }
-        std::cout << "\n";
-    }
-};
+#include "bar_builder.h"
+#include "book_manager.h"
+#include "book_signals.h"
+#include "instrument.h"
+#include "order_book.h"
+#include "price_calculator.h"
+#include "price_sketches.h"
+#include "rolling_vwap.h"
+#include "vwap_reduction.h"
 
 int main() {
     PriceCalculator calculator;
@@ -214,6 +36,208 @@ int main() {
     
     std::cout << "VWAP using range-based for: " << std::fixed << std::setprecision(2) << vwap1 << "\n";
     std::cout << "VWAP using pointer arithmetic: " << std::fixed << std::setprecision(2) << vwap2 << "\n";
+
+    // Compensated, parallel VWAP over a large array gives the same bits for any thread count.
+    // One huge print followed by 2M tiny ones: each tiny price * volume is below
+    // half an ulp of the running naive sum and is rounded away.
+    std::cout << "\n=== COMPENSATED PARALLEL VWAP ===\n";
+    std::vector<std::pair<double, int>> history;
+    history.reserve(2'000'001);
+    history.push_back(std::make_pair(1e10, 1'000'000));
+    for (int i = 0; i < 2'000'000; i++) {
+        history.push_back(std::make_pair(0.05 + (i % 1000) * 0.0001, 1 + i % 9));
+    }
+    std::cout << std::setprecision(4);
+    std::cout << "Naive:        " << calculator.calculateVWAP(history) << "\n";
+    std::cout << "Compensated:  " << calculateVWAPCompensated(history) << "\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::cout << "Parallel x" << threads << ":  " << calculateVWAPParallel(history, threads) << "\n";
+    }
+    std::cout << std::setprecision(2);
+
+    // Execution cost: walk the best levels of the book
+    std::cout << "\n=== DEPTH-LIMITED VWAP ===\n";
+    std::cout << "Top 5 bid levels VWAP: " << calculator.calculateTopLevelsVWAP(Side::Bid, 5) << "\n";
+    std::cout << "Top 5 ask levels VWAP: " << calculator.calculateTopLevelsVWAP(Side::Ask, 5) << "\n";
+    long long filled = 0;
+    double buyPrice = calculator.calculateFillVWAP(Side::Ask, 5000, &filled);
+    std::cout << "Buy 5000: average fill " << buyPrice << " (" << filled << " filled)\n";
+    double sellPrice = calculator.calculateFillVWAP(Side::Bid, 5000, &filled);
+    std::cout << "Sell 5000: average fill " << sellPrice << " (" << filled << " filled)\n";
+
+    // Microstructure signals, published through a seqlock for other threads
+    std::cout << "\n=== BOOK SIGNALS ===\n";
+    BookSignalPublisher<5> publisher(calculator);
+    calculator.setDeltaListener(&publisher);
+    calculator.addBid(100.995, 2500);
+    calculator.setDeltaListener(nullptr);
+    BookSignals signals = publisher.read();
+    std::cout << std::setprecision(4);
+    std::cout << "Spread: " << signals.spread << ", Mid: " << signals.mid
+              << ", Microprice: " << signals.microprice << "\n";
+    std::cout << "Top-5 imbalance: " << signals.imbalance
+              << ", Depth-weighted mid: " << signals.depthWeightedMid
+              << " (after " << signals.updates << " updates)\n";
+    std::cout << std::setprecision(2);
+
+    // Downstream replica rebuilt from a snapshot plus the delta stream
+    std::cout << "\n=== SNAPSHOT + DELTAS ===\n";
+    BookDeltaBuffer deltaBuffer;
+    calculator.setDeltaListener(&deltaBuffer);
+    std::vector<uint8_t> snapshotBytes;
+    calculator.serializeSnapshot(snapshotBytes);
+    calculator.addBid(101.00, 700);
+    calculator.addAsk(101.01, 300);
+    calculator.removeBid(100.99, 50);
+    calculator.removeAsk(101.02, 100'000);
+    calculator.setDeltaListener(nullptr);
+
+    std::vector<uint8_t> deltaBytes;
+    bookwire::encodeDeltas(deltaBuffer.getDeltas(), deltaBytes);
+    PriceCalculator replica(0);
+    replica.loadSnapshot(snapshotBytes);
+    for (const auto& delta : bookwire::decodeDeltas(deltaBytes)) {
+        replica.applyDelta(delta);
+    }
+    bool identical = replica.getBids() == calculator.getBids() &&
+                     replica.getAsks() == calculator.getAsks();
+    std::cout << "Snapshot: " << snapshotBytes.size() << " bytes, "
+              << deltaBuffer.getDeltas().size() << " deltas: " << deltaBytes.size() << " bytes\n";
+    std::cout << "Replica at sequence " << replica.getSequence() << " matches: "
+              << (identical ? "yes" : "no") << "\n";
+
+    // One book per symbol, addressed by interned id
+    std::cout << "\n=== MULTI-SYMBOL BOOKS ===\n";
+    BookManager manager(16, 64);
+    SymbolId aapl = manager.addSymbol("AAPL");
+    SymbolId msft = manager.addSymbol("MSFT");
+    std::vector<BookUpdate> updates = {
+        {aapl, Side::Bid, 189.95, 300}, {aapl, Side::Ask, 190.05, 200},
+        {msft, Side::Bid, 419.90, 500}, {msft, Side::Ask, 420.10, 100},
+        {aapl, Side::Bid, 190.00, 400}, {msft, Side::Ask, 420.05, 250},
+        {aapl, Side::Bid, 190.00, 150, UpdateAction::Set}, {msft, Side::Ask, 420.05, 0, UpdateAction::Delete},
+    };
+    manager.applyUpdates(updates);
+    for (SymbolId id = 0; id < manager.symbolCount(); id++) {
+        const PriceCalculator& book = manager.book(id);
+        std::cout << manager.symbolName(id) << ": best bid " << book.getBids().back().first
+                  << ", best ask " << book.getAsks().back().first << "\n";
+    }
+
+    // Order-by-order book: cancels and fills address orders by id
+    std::cout << "\n=== L3 ORDER BOOK ===\n";
+    OrderBook orderBook;
+    orderBook.addOrder(1, Side::Bid, 100.99, 300);
+    orderBook.addOrder(2, Side::Bid, 100.99, 200);
+    orderBook.addOrder(3, Side::Bid, 100.98, 500);
+    orderBook.addOrder(4, Side::Ask, 101.01, 400);
+    orderBook.executeOrder(1, 100);
+    orderBook.cancelOrder(3);
+    orderBook.modifyOrder(2, 50);
+    if (auto bestBid = orderBook.bestLevel(Side::Bid)) {
+        std::cout << "Best bid " << bestBid->price << ": " << bestBid->totalQuantity << " in "
+                  << bestBid->orderCount << " orders, queue head id " << bestBid->headOrderId << "\n";
+    }
+    std::cout << "Bid VWAP from L3 book: " << calculator.calculateVWAP(orderBook.aggregatedLevels(Side::Bid))
+              << "\n";
+
+    // Instrument classes fixed at compile time: tick conversion and ladder size
+    std::cout << "\n=== COMPILE-TIME INSTRUMENT CLASSES ===\n";
+    using Equity = Instrument<UsEquityClass>;
+    constexpr int64_t equityTicks = Equity::toTicks(189.95);
+    std::cout << "US equity: 189.95 -> tick " << equityTicks << " -> " << Equity::toPrice(equityTicks)
+              << ", 0.5 -> tick " << Equity::toTicks(0.5) << ", ladder " << Equity::ladderSize
+              << " levels\n";
+    std::cout << "Index future ladder: " << Instrument<IndexFutureClass>::ladderSize
+              << " levels, FX spot ladder: " << Instrument<FxSpotClass>::ladderSize << " levels\n";
+    TickLadder<UsEquityClass> ladder;
+    ladder.add(Side::Bid, 189.95, 300);
+    ladder.add(Side::Ask, 190.00, 200);
+    bool rejected = !ladder.add(Side::Bid, 189.955, 100);  // Not on the cent grid
+    std::cout << "Ladder best " << ladder.bestBidPrice() << " / " << ladder.bestAskPrice()
+              << ", off-tick order rejected: " << (rejected ? "yes" : "no") << "\n";
+
+    // Rolling VWAP/TWAP over 1s, 1m and 5m windows
+    std::cout << "\n=== ROLLING WINDOW VWAP/TWAP ===\n";
+    const int64_t second = 1'000'000'000;
+    MarketConfig tradeConfig;
+    tradeConfig.meanTradeGapNanos = 500'000'000;  // About two trades per second
+    // Ring sized for twice the expected trades in the 5m window, so it never grows
+    RollingWindowAnalytics rolling({second, 60 * second, 300 * second},
+                                   2 * 300 * second / tradeConfig.meanTradeGapNanos);
+    MarketGenerator tradeGenerator(tradeConfig);
+    std::vector<Trade> trades;
+    tradeGenerator.generateTrades(600, 0, trades);
+    for (const auto& trade : trades) {
+        rolling.addTrade(trade.timestamp, trade.price, trade.volume);
+    }
+    int64_t now = trades.back().timestamp;
+    const char* names[] = {"1s", "1m", "5m"};
+    for (std::size_t w = 0; w < rolling.windowCount(); w++) {
+        std::cout << names[w] << " window: VWAP = " << rolling.vwap(w)
+                  << ", TWAP = " << rolling.twap(w, now)
+                  << ", trades = " << rolling.tradeCount(w) << "\n";
+    }
+    std::cout << "Out-of-order trades rejected: " << rolling.rejectedCount() << "\n";
     
+    // Risk inputs: two halves of the stream sketched separately, then merged
+    std::cout << "\n=== STREAMING RISK STATS ===\n";
+    SymbolRiskStats firstHalf;
+    SymbolRiskStats secondHalf(0.05, 200, 99);
+    for (std::size_t i = 0; i < trades.size(); i++) {
+        (i < trades.size() / 2 ? firstHalf : secondHalf).onTrade(trades[i].price, trades[i].volume);
+    }
+    std::cout << std::setprecision(4);
+    std::cout << "EWMA price: " << secondHalf.ewma().getMean()
+              << ", EWMA std dev: " << secondHalf.ewma().getStdDev() << "\n";
+    firstHalf.merge(secondHalf);
+    std::cout << "Realized vol: " << firstHalf.realizedVolatility().getVolatility()
+              << " over " << firstHalf.realizedVolatility().getReturnCount() << " returns\n";
+    std::cout << "Price p5/p50/p95: " << firstHalf.prices().quantile(0.05) << " / "
+              << firstHalf.prices().quantile(0.5) << " / " << firstHalf.prices().quantile(0.95)
+              << ", size p50: " << firstHalf.sizes().quantile(0.5) << "\n";
+    std::cout << std::setprecision(2);
+
+    // OHLCV bars for 1s and 1m from the same ticks, streaming and batch
+    std::cout << "\n=== OHLCV BARS ===\n";
+    BarBuffer streamed;
+    BarBuilder streamBuilder(aapl, {second, 60 * second}, &streamed);
+    for (const auto& trade : trades) {
+        streamBuilder.addTrade(trade);
+    }
+    streamBuilder.flush();
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int> volumes;
+    for (const auto& trade : trades) {
+        timestamps.push_back(trade.timestamp);
+        prices.push_back(trade.price);
+        volumes.push_back(trade.volume);
+    }
+    BarBuffer batched;
+    BarBuilder batchBuilder(aapl, {second, 60 * second}, &batched);
+    batchBuilder.addTrades(timestamps, prices, volumes);
+    batchBuilder.flush();
+
+    for (const auto& bar : streamed.getBars()) {
+        if (bar.interval != 60 * second) continue;
+        std::cout << "1m bar @" << bar.start / second << "s: O " << bar.open << " H " << bar.high
+                  << " L " << bar.low << " C " << bar.close << " V " << bar.volume
+                  << " VWAP " << bar.vwap << " (" << bar.count << " ticks)\n";
+    }
+    // Batch mode emits the same bars in the same order; only VWAP may differ in the last bits
+    bool sameBars = streamed.getBars().size() == batched.getBars().size();
+    for (std::size_t i = 0; sameBars && i < streamed.getBars().size(); i++) {
+        const Bar& a = streamed.getBars()[i];
+        const Bar& b = batched.getBars()[i];
+        sameBars = a.interval == b.interval && a.start == b.start && a.open == b.open &&
+                   a.high == b.high && a.low == b.low && a.close == b.close &&
+                   a.volume == b.volume && a.count == b.count &&
+                   std::fabs(a.vwap - b.vwap) <= 1e-12 * a.vwap;
+    }
+    std::cout << streamed.getBars().size() << " bars streamed, " << batched.getBars().size()
+              << " bars in batch mode, identical: " << (sameBars ? "yes" : "no") << "\n";
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,574 @@
+#ifndef PRICE_CALCULATOR_H
+#define PRICE_CALCULATOR_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "book_delta.h"
+#include "market_generator.h"
+#include "market_types.h"
+
+class PriceCalculator {
+private:
+    // A vector for bids and asks, one entry per price level.
+    // Both sides are kept sorted from worst to best price, so the best
+    // level is always at the back and top-of-book updates are cheap.
+    std::vector<std::pair<double, int>> bids;
+    std::vector<std::pair<double, int>> asks;
+
+    // Optional receiver of L2 deltas (not owned). Every mutation bumps the
+    // sequence number whether or not anyone is listening.
+    BookDeltaListener* deltaListener = nullptr;
+    uint64_t sequence = 0;
+
+    void emit(Side side, DeltaAction action, double price, int volume) {
+        sequence++;
+        if (deltaListener != nullptr) {
+            deltaListener->onDelta(BookDelta{sequence, price, volume, action, side});
+        }
+    }
+
+    std::vector<std::pair<double, int>>& levelsFor(Side side) {
+        return side == Side::Bid ? bids : asks;
+    }
+
+    // Bids improve upwards, asks downwards
+    static bool isWorse(Side side, double a, double b) {
+        return side == Side::Bid ? a < b : a > b;
+    }
+
+    // First level in `levels` that is not worse than `price`
+    static std::vector<std::pair<double, int>>::iterator findLevel(
+        std::vector<std::pair<double, int>>& levels, Side side, double price) {
+        return std::lower_bound(levels.begin(), levels.end(), price,
+                                [side](const std::pair<double, int>& level, double p) {
+                                    return isWorse(side, level.first, p);
+                                });
+    }
+
+    // Insert or aggregate a level, keeping the side sorted worst to best
+    void insertLevel(Side side, double price, int volume) {
+        auto& levels = levelsFor(side);
+        // Fast path: new best price (the common case when building a book)
+        if (levels.empty() || isWorse(side, levels.back().first, price)) {
+            levels.push_back(std::make_pair(price, volume));
+            emit(side, DeltaAction::Add, price, volume);
+            return;
+        }
+        auto it = findLevel(levels, side, price);
+        if (it != levels.end() && it->first == price) {
+            it->second += volume;
+            emit(side, DeltaAction::Change, price, it->second);
+        } else {
+            levels.insert(it, std::make_pair(price, volume));
+            emit(side, DeltaAction::Add, price, volume);
+        }
+    }
+
+    // Take volume off a level, deleting it when nothing is left
+    void removeLevel(Side side, double price, int volume) {
+        auto& levels = levelsFor(side);
+        auto it = findLevel(levels, side, price);
+        if (it == levels.end() || it->first != price) {
+            throw std::invalid_argument("Price level not found");
+        }
+        it->second -= volume;
+        if (it->second <= 0) {
+            levels.erase(it);
+            emit(side, DeltaAction::Delete, price, 0);
+        } else {
+            emit(side, DeltaAction::Change, price, it->second);
+        }
+    }
+
+    // Set a level to an absolute volume (0 deletes it). Returns what happened
+    // to the level, or nothing when deleting a level that is not there.
+    std::optional<DeltaAction> setLevel(Side side, double price, int volume) {
+        auto& levels = levelsFor(side);
+        auto it = findLevel(levels, side, price);
+        const bool exists = it != levels.end() && it->first == price;
+        if (volume <= 0) {
+            if (!exists) return std::nullopt;
+            levels.erase(it);
+            return DeltaAction::Delete;
+        }
+        if (exists) {
+            it->second = volume;
+            return DeltaAction::Change;
+        }
+        levels.insert(it, std::make_pair(price, volume));
+        return DeltaAction::Add;
+    }
+
+    // setLevel for a local update, emitting the resulting delta
+    void replaceLevel(Side side, double price, int volume) {
+        if (auto action = setLevel(side, price, volume)) {
+            emit(side, *action, price, *action == DeltaAction::Delete ? 0 : volume);
+        }
+    }
+
+    // Scratch space reused by batch inserts so steady-state batches do not allocate
+    std::vector<std::pair<double, int>> batchSorted;
+    std::vector<std::pair<double, int>> batchTemp;
+    std::vector<std::pair<double, int>> mergeBuffer;
+
+    // Below this size a batch is cheaper to insert level by level (on a shuffled
+    // snapshot the merge only wins from roughly 150-200 levels, see bench_batch_insert)
+    static constexpr std::size_t batchMergeThreshold = 160;
+
+    // Sort `levels` by ascending price. Positive doubles order the same way as
+    // their IEEE-754 bit patterns, so they are radix sorted as 64-bit integer
+    // keys (byte passes where every key agrees are skipped). Anything else
+    // falls back to std::sort.
+    void sortByPrice(std::vector<std::pair<double, int>>& levels) {
+        bool allPositive = true;
+        for (const auto& level : levels) {
+            allPositive &= level.first > 0.0;
+        }
+        if (!allPositive) {
+            std::sort(levels.begin(), levels.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+            return;
+        }
+
+        batchTemp.resize(levels.size());
+        std::pair<double, int>* from = levels.data();
+        std::pair<double, int>* to = batchTemp.data();
+        const std::size_t n = levels.size();
+        for (int shift = 0; shift < 64; shift += 8) {
+            std::size_t counts[256] = {};
+            for (std::size_t i = 0; i < n; i++) {
+                counts[(std::bit_cast<uint64_t>(from[i].first) >> shift) & 0xFF]++;
+            }
+            // Every key has the same byte here: the pass would be a plain copy
+            if (counts[(std::bit_cast<uint64_t>(from[0].first) >> shift) & 0xFF] == n) {
+                continue;
+            }
+            std::size_t offset = 0;
+            for (auto& count : counts) {
+                std::size_t c = count;
+                count = offset;
+                offset += c;
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                to[counts[(std::bit_cast<uint64_t>(from[i].first) >> shift) & 0xFF]++] = from[i];
+            }
+            std::swap(from, to);
+        }
+        if (from != levels.data()) {
+            std::copy(from, from + n, levels.data());
+        }
+    }
+
+    // Merge a batch into one side in a single pass, aggregating equal prices
+    void mergeBatch(Side side, std::span<const std::pair<double, int>> batch) {
+        if (batch.empty()) return;
+        // NaN has no place in a price order and would break the sort, so the
+        // whole batch is rejected before anything is applied
+        for (const auto& level : batch) {
+            if (std::isnan(level.first)) {
+                throw std::invalid_argument("Batch contains a NaN price");
+            }
+        }
+        if (batch.size() < batchMergeThreshold) {
+            for (const auto& level : batch) {
+                insertLevel(side, level.first, level.second);
+            }
+            return;
+        }
+
+        auto& levels = levelsFor(side);
+        batchSorted.assign(batch.begin(), batch.end());
+        sortByPrice(batchSorted);
+        if (side == Side::Ask) {
+            std::reverse(batchSorted.begin(), batchSorted.end());
+        }
+
+        mergeBuffer.clear();
+        mergeBuffer.reserve(levels.size() + batchSorted.size());
+        auto append = [&](const std::pair<double, int>& level, bool fromBatch) {
+            if (!mergeBuffer.empty() && mergeBuffer.back().first == level.first) {
+                mergeBuffer.back().second += level.second;
+                emit(side, DeltaAction::Change, level.first, mergeBuffer.back().second);
+            } else {
+                mergeBuffer.push_back(level);
+                if (fromBatch) emit(side, DeltaAction::Add, level.first, level.second);
+            }
+        };
+
+        // On equal prices the existing level goes first, so the batch aggregates into it
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < levels.size() && j < batchSorted.size()) {
+            if (isWorse(side, batchSorted[j].first, levels[i].first)) {
+                append(batchSorted[j++], true);
+            } else {
+                append(levels[i++], false);
+            }
+        }
+        while (i < levels.size()) append(levels[i++], false);
+        while (j < batchSorted.size()) append(batchSorted[j++], true);
+
+        levels.swap(mergeBuffer);
+    }
+
+public:
+    explicit PriceCalculator(int initialLevels = 100, uint64_t seed = MarketConfig().seed) {
+        // Initialize with some default prices
+        generateInitialPrices(initialLevels, seed);
+    }
+
+    // Generate initial bid and ask prices around a mid of 101.00, one cent apart.
+    // The same seed always produces the same book.
+    void generateInitialPrices(int levels = 100, uint64_t seed = MarketConfig().seed) {
+        if (levels <= 0) return;
+        MarketConfig config;
+        config.seed = seed;
+        MarketGenerator generator(config);
+
+        std::vector<std::pair<double, int>> generated;
+        generator.generateBids(levels, generated);
+        addBids(generated);
+        generated.clear();
+        generator.generateAsks(levels, generated);
+        addAsks(generated);
+    }
+
+    // Add a bid
+    void addBid(double price, int volume) {
+        insertLevel(Side::Bid, price, volume);
+    }
+
+    // Add an ask
+    void addAsk(double price, int volume) {
+        insertLevel(Side::Ask, price, volume);
+    }
+
+    // Add many bids at once, e.g. from a feed snapshot. The batch may be in any
+    // order; it is sorted and merged into the book in one pass.
+    void addBids(std::span<const std::pair<double, int>> levels) {
+        mergeBatch(Side::Bid, levels);
+    }
+
+    // Add many asks at once
+    void addAsks(std::span<const std::pair<double, int>> levels) {
+        mergeBatch(Side::Ask, levels);
+    }
+
+    // Remove volume from a bid level; the level is deleted when it reaches zero
+    void removeBid(double price, int volume) {
+        removeLevel(Side::Bid, price, volume);
+    }
+
+    // Remove volume from an ask level
+    void removeAsk(double price, int volume) {
+        removeLevel(Side::Ask, price, volume);
+    }
+
+    // Set a bid level to an absolute volume, as an L2 feed reports it; 0 deletes the level
+    void setBid(double price, int volume) {
+        replaceLevel(Side::Bid, price, volume);
+    }
+
+    // Set an ask level to an absolute volume; 0 deletes the level
+    void setAsk(double price, int volume) {
+        replaceLevel(Side::Ask, price, volume);
+    }
+
+    // Receive a BookDelta for every level change; pass nullptr to stop
+    void setDeltaListener(BookDeltaListener* listener) {
+        deltaListener = listener;
+    }
+
+    // Sequence number of the last mutation
+    uint64_t getSequence() const {
+        return sequence;
+    }
+
+    // Write the full book in the bookwire snapshot format
+    void serializeSnapshot(std::vector<uint8_t>& out) const {
+        out.reserve(out.size() + bookwire::snapshotHeaderSize +
+                    (bids.size() + asks.size()) * bookwire::levelSize);
+        out.insert(out.end(), bookwire::snapshotMagic, bookwire::snapshotMagic + 4);
+        bookwire::put(out, bookwire::snapshotFormat);
+        bookwire::put(out, uint16_t{0});
+        bookwire::put(out, sequence);
+        bookwire::put(out, static_cast<uint32_t>(bids.size()));
+        bookwire::put(out, static_cast<uint32_t>(asks.size()));
+        for (const auto* side : {&bids, &asks}) {
+            for (const auto& level : *side) {
+                bookwire::put(out, level.first);
+                bookwire::put(out, static_cast<int32_t>(level.second));
+            }
+        }
+    }
+
+    // Replace the book with a serialized snapshot. No deltas are emitted.
+    void loadSnapshot(std::span<const uint8_t> in) {
+        if (in.size() < bookwire::snapshotHeaderSize ||
+            std::memcmp(in.data(), bookwire::snapshotMagic, 4) != 0) {
+            throw std::runtime_error("Not a book snapshot");
+        }
+        std::size_t offset = 4;
+        if (bookwire::get<uint16_t>(in, offset) != bookwire::snapshotFormat) {
+            throw std::runtime_error("Unsupported snapshot format");
+        }
+        bookwire::get<uint16_t>(in, offset);
+        const uint64_t snapshotSequence = bookwire::get<uint64_t>(in, offset);
+        const uint32_t bidCount = bookwire::get<uint32_t>(in, offset);
+        const uint32_t askCount = bookwire::get<uint32_t>(in, offset);
+        if (in.size() != offset + (static_cast<std::size_t>(bidCount) + askCount) * bookwire::levelSize) {
+            throw std::runtime_error("Snapshot size does not match level counts");
+        }
+
+        std::vector<std::pair<double, int>> newBids;
+        std::vector<std::pair<double, int>> newAsks;
+        newBids.reserve(bidCount);
+        newAsks.reserve(askCount);
+        for (auto [side, levels, count] : {std::tuple{Side::Bid, &newBids, bidCount},
+                                           std::tuple{Side::Ask, &newAsks, askCount}}) {
+            for (uint32_t i = 0; i < count; i++) {
+                double price = bookwire::get<double>(in, offset);
+                int volume = bookwire::get<int32_t>(in, offset);
+                if (!levels->empty() && !isWorse(side, levels->back().first, price)) {
+                    throw std::runtime_error("Snapshot levels are not sorted");
+                }
+                levels->push_back(std::make_pair(price, volume));
+            }
+        }
+        bids.swap(newBids);
+        asks.swap(newAsks);
+        sequence = snapshotSequence;
+    }
+
+    // Apply one delta from another book's stream. Deltas must arrive in
+    // sequence order; older ones are ignored and a gap throws.
+    void applyDelta(const BookDelta& delta) {
+        if (delta.sequence <= sequence) return;
+        if (delta.sequence != sequence + 1) {
+            throw std::runtime_error("Delta sequence gap");
+        }
+        setLevel(delta.side, delta.price, delta.action == DeltaAction::Delete ? 0 : delta.volume);
+        sequence = delta.sequence;
+        if (deltaListener != nullptr) {
+            deltaListener->onDelta(delta);
+        }
+    }
+
+    // Pre-size both sides so inserts up to `levels` deep never reallocate
+    void reserveLevels(std::size_t levels) {
+        bids.reserve(levels);
+        asks.reserve(levels);
+    }
+
+    // Book levels ordered from worst to best price
+    const std::vector<std::pair<double, int>>& getBids() const {
+        return bids;
+    }
+
+    const std::vector<std::pair<double, int>>& getAsks() const {
+        return asks;
+    }
+
+    // VWAP of the best `levels` price levels on one side of the book.
+    // Only the levels touched are visited.
+    double calculateTopLevelsVWAP(Side side, std::size_t levels) const {
+        const auto& book = (side == Side::Bid) ? bids : asks;
+        const std::size_t count = std::min(levels, book.size());
+        if (count == 0) return 0.0;
+
+        double totalVolume = 0;
+        double totalPriceVolume = 0;
+        const std::pair<double, int>* ptr = book.data() + book.size();
+        const std::pair<double, int>* stopPtr = ptr - count;
+        while (ptr > stopPtr) {
+            ptr--;
+            totalVolume += ptr->second;
+            totalPriceVolume += ptr->first * ptr->second;
+        }
+        return totalPriceVolume / totalVolume;
+    }
+
+    // Average fill price for taking `quantity` from one side of the book,
+    // walking from the best level outwards (a buy walks Side::Ask).
+    // If the side has less than `quantity`, the VWAP of what is available is
+    // returned. The quantity actually filled is written to `filled` if non-null.
+    double calculateFillVWAP(Side side, long long quantity, long long* filled = nullptr) const {
+        const auto& book = (side == Side::Bid) ? bids : asks;
+        long long remaining = quantity;
+        double totalPriceVolume = 0;
+
+        const std::pair<double, int>* ptr = book.data() + book.size();
+        const std::pair<double, int>* beginPtr = book.data();
+        while (remaining > 0 && ptr > beginPtr) {
+            ptr--;
+            long long take = std::min<long long>(remaining, ptr->second);
+            totalPriceVolume += ptr->first * take;
+            remaining -= take;
+        }
+
+        long long done = (quantity > 0) ? quantity - remaining : 0;
+        if (filled != nullptr) *filled = done;
+        if (done == 0) return 0.0;
+        return totalPriceVolume / done;
+    }
+
+    // Calculate Volume Weighted Average Price for the vector of bids
+    double calculateVWAP(const std::vector<std::pair<double, int>>& bids) {
+        double totalVolume = 0;
+        double totalPriceVolume = 0;
+        for (const auto& bid : bids) {
+            totalVolume += bid.second;
+            totalPriceVolume += bid.first * bid.second;
+        }
+        return totalPriceVolume / totalVolume;
+    }
+
+    // Calculate VWAP using pointer arithmetic
+    double calculateVWAPWithPointers(const std::vector<std::pair<double, int>>& bids) {
+        if (bids.empty()) return 0.0;
+        
+        double totalVolume = 0;
+        double totalPriceVolume = 0;
+        
+        const std::pair<double, int>* ptr = bids.data();
+        const std::pair<double, int>* endPtr = bids.data() + bids.size();
+        
+        while (ptr < endPtr) {
+            totalVolume += ptr->second;
+            totalPriceVolume += ptr->first * ptr->second;
+            ptr++;
+        }
+        
+        return totalPriceVolume / totalVolume;
+    }
+
+    // Demonstrate pointer arithmetic with raw arrays
+    void demonstratePointerArithmetic() {
+        std::cout << "\n=== POINTER ARITHMETIC DEMONSTRATIONS ===\n";
+        
+        // Create a simple array for demonstration
+        double prices[] = {100.50, 101.25, 102.00, 103.75, 104.50};
+        int volumes[] = {1000, 1500, 2000, 1750, 1200};
+        const int size = 5;
+        
+        std::cout << "Original arrays:\n";
+        std::cout << "Prices: ";
+        for (int i = 0; i < size; i++) {
+            std::cout << prices[i] << " ";
+        }
+        std::cout << "\nVolumes: ";
+        for (int i = 0; i < size; i++) {
+            std::cout << volumes[i] << " ";
+        }
+        std::cout << "\n\n";
+        
+        // Method 1: Basic pointer arithmetic traversal
+        std::cout << "1. Basic pointer arithmetic traversal:\n";
+        double* pricePtr = prices;
+        int* volumePtr = volumes;
+        
+        for (int i = 0; i < size; i++) {
+            std::cout << "Price[" << i << "] = " << *(pricePtr + i) 
+                      << ", Volume[" << i << "] = " << *(volumePtr + i) << "\n";
+        }
+        
+        // Method 2: Pointer increment traversal
+        std::cout << "\n2. Pointer increment traversal:\n";
+        pricePtr = prices;
+        volumePtr = volumes;
+        
+        for (int i = 0; i < size; i++) {
+            std::cout << "Price[" << i << "] = " << *pricePtr 
+                      << ", Volume[" << i << "] = " << *volumePtr << "\n";
+            pricePtr++;  // Move to next element
+            volumePtr++; // Move to next element
+        }
+        
+        // Method 3: Pointer arithmetic for reverse traversal
+        std::cout << "\n3. Reverse traversal using pointer arithmetic:\n";
+        pricePtr = prices + size - 1;  // Point to last element
+        volumePtr = volumes + size - 1;
+        
+        for (int i = size - 1; i >= 0; i--) {
+            std::cout << "Price[" << i << "] = " << *pricePtr 
+                      << ", Volume[" << i << "] = " << *volumePtr << "\n";
+            pricePtr--;  // Move to previous element
+            volumePtr--;
+        }
+        
+        // Method 4: Pointer arithmetic for finding array bounds
+        std::cout << "\n4. Array bounds using pointer arithmetic:\n";
+        double* beginPtr = prices;
+        double* endPtr = prices + size;
+        
+        std::cout << "Array starts at: " << beginPtr << "\n";
+        std::cout << "Array ends at: " << endPtr << "\n";
+        std::cout << "Number of elements: " << (endPtr - beginPtr) << "\n";
+        
+        // Method 5: Pointer arithmetic for array manipulation
+        std::cout << "\n5. Array manipulation using pointers:\n";
+        pricePtr = prices;
+        volumePtr = volumes;
+        
+        // Double all prices and volumes
+        for (int i = 0; i < size; i++) {
+            *pricePtr *= 2.0;
+            *volumePtr *= 2;
+            pricePtr++;
+            volumePtr++;
+        }
+        
+        // Display modified arrays
+        std::cout << "Modified arrays (doubled):\n";
+        std::cout << "Prices: ";
+        for (int i = 0; i < size; i++) {
+            std::cout << prices[i] << " ";
+        }
+        std::cout << "\nVolumes: ";
+        for (int i = 0; i < size; i++) {
+            std::cout << volumes[i] << " ";
+        }
+        std::cout << "\n";
+        
+        // Method 6: Pointer arithmetic for finding specific elements
+        std::cout << "\n6. Finding elements using pointer arithmetic:\n";
+        pricePtr = prices;
+        volumePtr = volumes;
+        
+        // Find the maximum price
+        double* maxPricePtr = pricePtr;
+        for (int i = 1; i < size; i++) {
+            if (*(pricePtr + i) > *maxPricePtr) {
+                maxPricePtr = pricePtr + i;
+            }
+        }
+        
+        int maxIndex = maxPricePtr - pricePtr;  // Calculate index using pointer arithmetic
+        std::cout << "Maximum price: " << *maxPricePtr << " at index " << maxIndex << "\n";
+        
+        // Method 7: Pointer arithmetic for array slicing
+        std::cout << "\n7. Array slicing using pointer arithmetic:\n";
+        double* sliceStart = prices + 1;  // Start from second element
+        double* sliceEnd = prices + 4;    // End at fourth element
+        
+        std::cout << "Slice from index 1 to 3: ";
+        for (double* ptr = sliceStart; ptr <= sliceEnd; ptr++) {
+            std::cout << *ptr << " ";
+        }
+        std::cout << "\n";
+    }
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef PRICE_SKETCHES_H
+#define PRICE_SKETCHES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "market_generator.h"
+
+// Exponentially weighted mean and variance, O(1) time and memory per update
+class EwmaStats {
+private:
+    double alpha;
+    double mean = 0.0;
+    double variance = 0.0;
+    bool initialized = false;
+
+public:
+    // alpha in (0, 1]: weight of the newest observation
+    explicit EwmaStats(double alpha = 0.05) : alpha(alpha) {
+        if (alpha <= 0.0 || alpha > 1.0) {
+            throw std::invalid_argument("alpha must be in (0, 1]");
+        }
+    }
+
+    void update(double x) {
+        if (!initialized) {
+            mean = x;
+            initialized = true;
+            return;
+        }
+        const double diff = x - mean;
+        const double increment = alpha * diff;
+        mean += increment;
+        variance = (1.0 - alpha) * (variance + diff * increment);
+    }
+
+    double getMean() const {
+        return mean;
+    }
+
+    double getVariance() const {
+        return variance;
+    }
+
+    double getStdDev() const {
+        return std::sqrt(variance);
+    }
+};
+
+// Realized volatility from squared log returns between consecutive prices.
+// Mergeable: sums from separate streams simply add up.
+class RealizedVolatility {
+private:
+    double sumSquaredReturns = 0.0;
+    uint64_t returns = 0;
+    double lastPrice = 0.0;
+
+public:
+    void update(double price) {
+        if (lastPrice > 0.0 && price > 0.0) {
+            const double r = std::log(price / lastPrice);
+            sumSquaredReturns += r * r;
+            returns++;
+        }
+        lastPrice = price;
+    }
+
+    void merge(const RealizedVolatility& other) {
+        sumSquaredReturns += other.sumSquaredReturns;
+        returns += other.returns;
+    }
+
+    // Square root of the summed squared returns over the whole stream
+    double getVolatility() const {
+        return std::sqrt(sumSquaredReturns);
+    }
+
+    // Volatility per return, scaled to `periods` returns (e.g. per day)
+    double getScaledVolatility(double periods) const {
+        if (returns == 0) return 0.0;
+        return std::sqrt(sumSquaredReturns / static_cast<double>(returns) * periods);
+    }
+
+    uint64_t getReturnCount() const {
+        return returns;
+    }
+};
+
+// KLL quantile sketch (Karnin, Lang, Liberty 2016).
+//
+// Items live in a stack of compactors; level h holds items of weight 2^h and
+// has a capacity that shrinks geometrically below the top level. A full
+// compactor is sorted and every other item is promoted one level up. Memory is
+// O(k log(n / k)) and rank error is roughly 1.7 / k. Two sketches with the
+// same k can be merged, e.g. per-thread sketches into a global one.
+// Randomness comes from a seeded Xoshiro256, so results are reproducible.
+class KllSketch {
+private:
+    std::size_t k;
+    std::vector<std::vector<double>> compactors;
+    std::size_t size = 0;
+    std::size_t maxSize = 0;
+    uint64_t count = 0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    Xoshiro256 rng;
+
+    std::size_t capacity(std::size_t level) const {
+        const std::size_t depth = compactors.size() - level - 1;
+        return static_cast<std::size_t>(std::ceil(std::pow(2.0 / 3.0, depth) * k)) + 1;
+    }
+
+    void grow() {
+        compactors.emplace_back();
+        maxSize = 0;
+        for (std::size_t h = 0; h < compactors.size(); h++) {
+            maxSize += capacity(h);
+        }
+    }
+
+    void compress() {
+        for (std::size_t h = 0; h < compactors.size(); h++) {
+            if (compactors[h].size() < capacity(h)) continue;
+            if (h + 1 >= compactors.size()) grow();
+
+            auto& level = compactors[h];
+            auto& next = compactors[h + 1];
+            std::sort(level.begin(), level.end());
+            // An odd item out stays behind at this level
+            const std::size_t pairs = level.size() / 2;
+            const std::size_t offset = static_cast<std::size_t>(rng() & 1);
+            const std::size_t base = level.size() - 2 * pairs;
+            for (std::size_t i = 0; i < pairs; i++) {
+                next.push_back(level[base + 2 * i + offset]);
+            }
+            level.resize(base);
+
+            size = 0;
+            for (const auto& c : compactors) size += c.size();
+            if (size < maxSize) break;
+        }
+    }
+
+public:
+    explicit KllSketch(std::size_t k = 200, uint64_t seed = 1) : k(k), rng(seed) {
+        if (k < 8) {
+            throw std::invalid_argument("k must be at least 8");
+        }
+        grow();
+    }
+
+    void update(double value) {
+        if (count == 0) {
+            minValue = maxValue = value;
+        } else {
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+        count++;
+        compactors[0].push_back(value);
+        size++;
+        if (size >= maxSize) compress();
+    }
+
+    void merge(const KllSketch& other) {
+        if (other.k != k) {
+            throw std::invalid_argument("Cannot merge sketches with different k");
+        }
+        if (other.count == 0) return;
+        while (compactors.size() < other.compactors.size()) grow();
+        for (std::size_t h = 0; h < other.compactors.size(); h++) {
+            compactors[h].insert(compactors[h].end(), other.compactors[h].begin(),
+                                 other.compactors[h].end());
+        }
+        minValue = count == 0 ? other.minValue : std::min(minValue, other.minValue);
+        maxValue = count == 0 ? other.maxValue : std::max(maxValue, other.maxValue);
+        count += other.count;
+
+        size = 0;
+        for (const auto& c : compactors) size += c.size();
+        while (size >= maxSize) compress();
+    }
+
+    // Approximate q-quantile for q in [0, 1]
+    double quantile(double q) const {
+        if (count == 0) return 0.0;
+        if (q <= 0.0) return minValue;
+        if (q >= 1.0) return maxValue;
+
+        std::vector<std::pair<double, uint64_t>> weighted;
+        weighted.reserve(size);
+        uint64_t totalWeight = 0;
+        for (std::size_t h = 0; h < compactors.size(); h++) {
+            for (double v : compactors[h]) {
+                weighted.emplace_back(v, uint64_t{1} << h);
+                totalWeight += uint64_t{1} << h;
+            }
+        }
+        std::sort(weighted.begin(), weighted.end());
+
+        const double target = q * static_cast<double>(totalWeight);
+        uint64_t cumulative = 0;
+        for (const auto& [value, weight] : weighted) {
+            cumulative += weight;
+            if (static_cast<double>(cumulative) >= target) return value;
+        }
+        return maxValue;
+    }
+
+    uint64_t getCount() const {
+        return count;
+    }
+
+    // Items currently retained (the sketch's memory footprint)
+    std::size_t retained() const {
+        return size;
+    }
+};
+
+// Per-symbol risk inputs fed from the same trades as the VWAP analytics
+class SymbolRiskStats {
+private:
+    EwmaStats priceEwma;
+    RealizedVolatility volatility;
+    KllSketch priceQuantiles;
+    KllSketch sizeQuantiles;
+
+public:
+    explicit SymbolRiskStats(double alpha = 0.05, std::size_t k = 200, uint64_t seed = 1)
+        : priceEwma(alpha), priceQuantiles(k, seed), sizeQuantiles(k, seed + 1) {}
+
+    void onTrade(double price, int volume) {
+        priceEwma.update(price);
+        volatility.update(price);
+        priceQuantiles.update(price);
+        sizeQuantiles.update(static_cast<double>(volume));
+    }
+
+    // Combine another stream's volatility and quantile sketches into this one.
+    // EWMA state is order-dependent and stays per stream.
+    void merge(const SymbolRiskStats& other) {
+        volatility.merge(other.volatility);
+        priceQuantiles.merge(other.priceQuantiles);
+        sizeQuantiles.merge(other.sizeQuantiles);
+    }
+
+    const EwmaStats& ewma() const {
+        return priceEwma;
+    }
+
+    const RealizedVolatility& realizedVolatility() const {
+        return volatility;
+    }
+
+    const KllSketch& prices() const {
+        return priceQuantiles;
+    }
+
+    const KllSketch& sizes() const {
+        return sizeQuantiles;
+    }
+};
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef ROLLING_VWAP_H
+#define ROLLING_VWAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "market_types.h"
+
+// Maintains VWAP and TWAP over several trailing time windows at once.
+//
+// All windows share one ring buffer of trades sized for the longest window.
+// Each window keeps its own tail index and running sums, so an update costs
+// O(number of windows) plus amortized O(1) expiry per trade.
+//
+// The double sums are kept by adding and subtracting, which leaves rounding
+// error behind. Each window re-sums them from the ring once it has expired
+// as many trades as it holds, so the error stays bounded at amortized O(1)
+// cost even if the window never empties.
+//
+// Size the ring for the most trades the longest window can hold. Going past
+// it doubles the ring, which copies it inside addTrade.
+class RollingWindowAnalytics {
+private:
+    struct Window {
+        int64_t length;            // Window length in nanoseconds
+        uint64_t tail;             // Sequence number of the oldest trade inside the window
+        double priceVolume;        // Sum of price * volume inside the window
+        int64_t volume;            // Sum of volume inside the window
+        double priceTime;          // Sum of price * duration for closed segments inside the window
+        double lastExpiredPrice;   // Price in force at the left edge of the window
+        bool hasExpired;           // True once at least one trade has left the window
+        uint64_t expiredSinceResum; // Trades expired since the sums were last rebuilt
+    };
+
+    std::vector<Trade> ring;       // Capacity is always a power of two
+    uint64_t mask;
+    uint64_t head;                 // Sequence number of the next trade to write
+    std::vector<Window> windows;
+    uint64_t rejected;             // Trades refused for going back in time
+
+    // Re-summing a window smaller than this is not worth the pass over the ring
+    static constexpr uint64_t minResumInterval = 64;
+
+    const Trade& at(uint64_t seq) const {
+        return ring[seq & mask];
+    }
+
+    uint64_t oldestTail() const {
+        uint64_t oldest = head;
+        for (const auto& w : windows) {
+            if (w.tail < oldest) oldest = w.tail;
+        }
+        return oldest;
+    }
+
+    // Resize the ring to `capacity` (a power of two), keeping trades still
+    // referenced by the longest window
+    void resizeRing(std::size_t capacity) {
+        std::vector<Trade> bigger(capacity);
+        uint64_t newMask = bigger.size() - 1;
+        for (uint64_t seq = oldestTail(); seq < head; seq++) {
+            bigger[seq & newMask] = at(seq);
+        }
+        ring.swap(bigger);
+        mask = newMask;
+    }
+
+    // Rebuild the double sums of a window exactly from the trades it holds
+    void resum(Window& w) {
+        double priceVolume = 0.0;
+        double priceTime = 0.0;
+        for (uint64_t seq = w.tail; seq < head; seq++) {
+            const Trade& t = at(seq);
+            priceVolume += t.price * t.volume;
+            if (seq + 1 < head) {
+                priceTime += t.price * static_cast<double>(at(seq + 1).timestamp - t.timestamp);
+            }
+        }
+        w.priceVolume = priceVolume;
+        w.priceTime = priceTime;
+        w.expiredSinceResum = 0;
+    }
+
+    // Drop trades that fall out of the window ending at `now`
+    void expire(Window& w, int64_t now) {
+        const int64_t cutoff = now - w.length;
+        while (w.tail < head && at(w.tail).timestamp <= cutoff) {
+            const Trade& t = at(w.tail);
+            w.priceVolume -= t.price * t.volume;
+            w.volume -= t.volume;
+            // The segment of t ends where the next trade starts
+            if (w.tail + 1 < head) {
+                w.priceTime -= t.price * static_cast<double>(at(w.tail + 1).timestamp - t.timestamp);
+            }
+            w.lastExpiredPrice = t.price;
+            w.hasExpired = true;
+            w.tail++;
+            w.expiredSinceResum++;
+        }
+        // Reset exactly once the window is empty, otherwise re-sum once as
+        // many trades have left as remain
+        if (w.tail == head) {
+            w.priceVolume = 0.0;
+            w.priceTime = 0.0;
+            w.volume = 0;
+            w.expiredSinceResum = 0;
+        } else if (w.expiredSinceResum >= minResumInterval &&
+                   w.expiredSinceResum >= head - w.tail) {
+            resum(w);
+        }
+    }
+
+public:
+    // windowLengths in nanoseconds, e.g. {1'000'000'000, 60'000'000'000}.
+    // initialCapacity is the most trades the longest window is expected to hold.
+    explicit RollingWindowAnalytics(const std::vector<int64_t>& windowLengths,
+                                    std::size_t initialCapacity = 1024)
+        : mask(0), head(0), rejected(0) {
+        if (windowLengths.empty()) {
+            throw std::invalid_argument("At least one window is required");
+        }
+        std::size_t capacity = 1;
+        while (capacity < initialCapacity) capacity <<= 1;
+        ring.resize(capacity);
+        mask = capacity - 1;
+
+        for (int64_t length : windowLengths) {
+            if (length <= 0) {
+                throw std::invalid_argument("Window length must be positive");
+            }
+            windows.push_back(Window{length, 0, 0.0, 0, 0.0, 0.0, false, 0});
+        }
+    }
+
+    // Make room for `trades` trades in the longest window up front, so
+    // addTrade never has to grow the ring
+    void reserve(std::size_t trades) {
+        std::size_t capacity = ring.size();
+        while (capacity < trades) capacity <<= 1;
+        if (capacity != ring.size()) {
+            resizeRing(capacity);
+        }
+    }
+
+    std::size_t windowCount() const {
+        return windows.size();
+    }
+
+    // Add a trade. Timestamps must be non-decreasing: an older trade is not
+    // added, is counted in rejectedCount(), and false is returned.
+    bool addTrade(int64_t timestamp, double price, int volume) {
+        if (head > 0 && timestamp < at(head - 1).timestamp) {
+            rejected++;
+            return false;
+        }
+
+        if (head - oldestTail() == ring.size()) {
+            resizeRing(ring.size() * 2);
+        }
+
+        for (auto& w : windows) {
+            // Close the previous trade's segment if it is still inside the window
+            if (w.tail < head) {
+                const Trade& prev = at(head - 1);
+                w.priceTime += prev.price * static_cast<double>(timestamp - prev.timestamp);
+            }
+            w.priceVolume += price * volume;
+            w.volume += volume;
+        }
+
+        ring[head & mask] = Trade{timestamp, price, volume};
+        head++;
+
+        for (auto& w : windows) {
+            expire(w, timestamp);
+        }
+        return true;
+    }
+
+    // Expire trades without adding a new one (e.g. on a timer)
+    void advanceTo(int64_t now) {
+        for (auto& w : windows) {
+            expire(w, now);
+        }
+    }
+
+    // VWAP of the trades currently inside window `index`, 0.0 if empty
+    double vwap(std::size_t index) const {
+        const Window& w = windows.at(index);
+        if (w.volume == 0) return 0.0;
+        return w.priceVolume / static_cast<double>(w.volume);
+    }
+
+    // Time-weighted average of the last traded price over window `index` ending at `now`.
+    // Call advanceTo(now) first if time has moved on since the last trade.
+    double twap(std::size_t index, int64_t now) const {
+        const Window& w = windows.at(index);
+        const int64_t start = now - w.length;
+
+        double area = 0.0;
+        int64_t covered = 0;
+        if (w.tail < head) {
+            const Trade& first = at(w.tail);
+            const Trade& last = at(head - 1);
+            area = w.priceTime + last.price * static_cast<double>(now - last.timestamp);
+            covered = now - first.timestamp;
+            // Price of the last expired trade was still in force at the left edge
+            if (w.hasExpired) {
+                area += w.lastExpiredPrice * static_cast<double>(first.timestamp - start);
+                covered = w.length;
+            }
+        } else if (w.hasExpired) {
+            return w.lastExpiredPrice;
+        }
+
+        if (covered <= 0) {
+            return w.tail < head ? at(head - 1).price : 0.0;
+        }
+        return area / static_cast<double>(covered);
+    }
+
+    // Number of trades currently inside window `index`
+    uint64_t tradeCount(std::size_t index) const {
+        return head - windows.at(index).tail;
+    }
+
+    // Number of trades refused because their timestamp went back in time
+    uint64_t rejectedCount() const {
+        return rejected;
+    }
+};
+
+#endif
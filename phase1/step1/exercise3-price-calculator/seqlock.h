@@ -0,0 +1,78 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock for small trivially copyable values.
+//
+// The writer never blocks. Readers retry if they overlap a write, which they
+// detect by an odd or changed sequence number. The payload is stored as
+// relaxed atomic words, so concurrent reads and writes are not a data race.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+private:
+    static constexpr std::size_t wordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    // Sequence and payload on separate cache lines from neighbouring objects
+    alignas(64) std::atomic<uint64_t> sequence{0};
+    std::array<std::atomic<uint64_t>, wordCount> words{};
+
+public:
+    SeqLock() = default;
+
+    explicit SeqLock(const T& initial) {
+        store(initial);
+    }
+
+    // Writer side: only one thread may call store
+    void store(const T& value) {
+        uint64_t buffer[wordCount] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        const uint64_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < wordCount; i++) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side: one attempt. Returns false if the read overlapped a write.
+    bool tryLoad(T& out) const {
+        uint64_t buffer[wordCount];
+        const uint64_t before = sequence.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < wordCount; i++) {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = sequence.load(std::memory_order_relaxed);
+        if ((before & 1) != 0 || before != after) {
+            return false;
+        }
+        std::memcpy(&out, buffer, sizeof(T));
+        return true;
+    }
+
+    // Reader side: any number of threads, returns a consistent copy
+    T load() const {
+        T value;
+        while (!tryLoad(value)) {
+        }
+        return value;
+    }
+
+    // Number of completed writes
+    uint64_t version() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+};
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef VWAP_REDUCTION_H
+#define VWAP_REDUCTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Neumaier (improved Kahan) compensated summation.
+// The running error term recovers the low-order bits lost by each addition.
+struct NeumaierSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double value) {
+        double t = sum + value;
+        if (std::fabs(sum) >= std::fabs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+
+    void add(const NeumaierSum& other) {
+        add(other.sum);
+        add(other.compensation);
+    }
+
+    double result() const {
+        return sum + compensation;
+    }
+};
+
+// Partial VWAP sums for one chunk of levels
+struct VWAPPartial {
+    NeumaierSum priceVolume;
+    int64_t volume = 0;  // Exact: integer volumes never lose precision
+};
+
+inline VWAPPartial reduceVWAPChunk(const std::pair<double, int>* begin,
+                                   const std::pair<double, int>* end) {
+    VWAPPartial partial;
+    for (const std::pair<double, int>* ptr = begin; ptr < end; ptr++) {
+        partial.priceVolume.add(ptr->first * ptr->second);
+        partial.volume += ptr->second;
+    }
+    return partial;
+}
+
+// Compensated VWAP on a single thread
+inline double calculateVWAPCompensated(const std::vector<std::pair<double, int>>& levels) {
+    if (levels.empty()) return 0.0;
+    VWAPPartial partial = reduceVWAPChunk(levels.data(), levels.data() + levels.size());
+    return partial.priceVolume.result() / static_cast<double>(partial.volume);
+}
+
+// Below this many levels, threads = 0 runs on the calling thread only
+inline constexpr std::size_t parallelVWAPCutover = 1 << 18;
+
+// Compensated VWAP split across `threads` worker threads.
+//
+// The input is cut into chunks of a fixed size that does not depend on the
+// thread count, and chunk results are combined in chunk order. The result is
+// therefore bit-identical for any number of threads.
+//
+// The worker threads are created and joined on every call, not kept in a
+// pool. That costs tens of microseconds per call (measured ~30 us for two
+// threads), so with the default threads = 0 inputs smaller than
+// parallelVWAPCutover are reduced on the calling thread and larger ones use
+// hardware concurrency. An explicit thread count is always honoured.
+inline double calculateVWAPParallel(const std::vector<std::pair<double, int>>& levels,
+                                    unsigned threads = 0,
+                                    std::size_t chunkSize = 1 << 16) {
+    if (levels.empty()) return 0.0;
+    if (chunkSize == 0) chunkSize = 1;
+    if (threads == 0) {
+        threads = levels.size() < parallelVWAPCutover
+                      ? 1u
+                      : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::size_t chunkCount = (levels.size() + chunkSize - 1) / chunkSize;
+    std::vector<VWAPPartial> partials(chunkCount);
+    const std::pair<double, int>* data = levels.data();
+    const std::size_t size = levels.size();
+
+    // Worker t handles chunks t, t + threads, t + 2 * threads, ...
+    auto work = [&](unsigned worker) {
+        for (std::size_t c = worker; c < chunkCount; c += threads) {
+            std::size_t begin = c * chunkSize;
+            std::size_t end = std::min(begin + chunkSize, size);
+            partials[c] = reduceVWAPChunk(data + begin, data + end);
+        }
+    };
+
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, chunkCount));
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    // Fixed-order combine keeps the result independent of scheduling
+    VWAPPartial total;
+    for (const auto& partial : partials) {
+        total.priceVolume.add(partial.priceVolume);
+        total.volume += partial.volume;
+    }
+    return total.priceVolume.result() / static_cast<double>(total.volume);
+}
+
+// Column (structure-of-arrays) layout: prices and volumes in separate arrays,
+// so a vector load picks up consecutive prices with no padding in between.
+struct PriceVolumeColumns {
+    std::vector<double> prices;
+    std::vector<int> volumes;
+
+    explicit PriceVolumeColumns(const std::vector<std::pair<double, int>>& levels) {
+        prices.reserve(levels.size());
+        volumes.reserve(levels.size());
+        for (const auto& level : levels) {
+            prices.push_back(level.first);
+            volumes.push_back(level.second);
+        }
+    }
+};
+
+// Scalar VWAP over columns with four independent accumulators, so consecutive
+// additions do not wait on each other
+inline double calculateVWAPColumns(const double* prices, const int* volumes, std::size_t n) {
+    if (n == 0) return 0.0;
+    double pv[4] = {0.0, 0.0, 0.0, 0.0};
+    int64_t vol[4] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int lane = 0; lane < 4; lane++) {
+            pv[lane] += prices[i + lane] * volumes[i + lane];
+            vol[lane] += volumes[i + lane];
+        }
+    }
+    for (; i < n; i++) {
+        pv[0] += prices[i] * volumes[i];
+        vol[0] += volumes[i];
+    }
+    return (pv[0] + pv[1] + pv[2] + pv[3]) / static_cast<double>(vol[0] + vol[1] + vol[2] + vol[3]);
+}
+
+// Explicit SIMD VWAP over columns: AVX2 (4 doubles per step, two accumulators)
+// when compiled with -mavx2, otherwise SSE2 (2 doubles per step).
+// Volumes are summed as exact integers.
+inline double calculateVWAPSimd(const double* prices, const int* volumes, std::size_t n) {
+    if (n == 0) return 0.0;
+    std::size_t i = 0;
+    double priceVolume = 0.0;
+    int64_t volume = 0;
+
+#if defined(__AVX2__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256i vacc = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(volumes + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(volumes + i + 4));
+#if defined(__FMA__)
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(prices + i), _mm256_cvtepi32_pd(v0), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(prices + i + 4), _mm256_cvtepi32_pd(v1), acc1);
+#else
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(prices + i), _mm256_cvtepi32_pd(v0)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(prices + i + 4), _mm256_cvtepi32_pd(v1)));
+#endif
+        vacc = _mm256_add_epi64(vacc, _mm256_cvtepi32_epi64(v0));
+        vacc = _mm256_add_epi64(vacc, _mm256_cvtepi32_epi64(v1));
+    }
+    alignas(32) double pvLanes[4];
+    alignas(32) int64_t volLanes[4];
+    _mm256_store_pd(pvLanes, _mm256_add_pd(acc0, acc1));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(volLanes), vacc);
+    priceVolume = pvLanes[0] + pvLanes[1] + pvLanes[2] + pvLanes[3];
+    volume = volLanes[0] + volLanes[1] + volLanes[2] + volLanes[3];
+#elif defined(__SSE2__)
+    __m128d acc = _mm_setzero_pd();
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(volumes + i));
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(prices + i), _mm_cvtepi32_pd(v)));
+        volume += static_cast<int64_t>(volumes[i]) + volumes[i + 1];
+    }
+    alignas(16) double pvLanes[2];
+    _mm_store_pd(pvLanes, acc);
+    priceVolume = pvLanes[0] + pvLanes[1];
+#endif
+
+    for (; i < n; i++) {
+        priceVolume += prices[i] * volumes[i];
+        volume += volumes[i];
+    }
+    return priceVolume / static_cast<double>(volume);
+}
+
+#endif